@@ -16,6 +16,9 @@ include 'workspace.lua'
 function platform_defines()
     print("Setting platform defines")
 
+    -- Number formatting is header inline, so the library and everything including it have to agree on it
+    defines{"CEREAL_DBL_PRECISION=5"}
+
     filter {"configurations:debug"}
         defines{"DEBUG"}
     filter {"configurations:release or profile"}
@@ -1,4 +1,5 @@
 PROJECTS = {
     PROJ_DIR .. "/cereal",
     PROJ_DIR .. "/test",
+    PROJ_DIR .. "/bench",
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Arena.h"
+
+namespace
+{
+
+constexpr size_t Records = 25'000; // 4 nodes per record, 100k nodes per document
+
+void Build(cereal::JsonObject& root)
+{
+    for (size_t i = 0; i < Records; ++i)
+    {
+        std::shared_ptr<cereal::JsonObject> record = root.CreateObject();
+        record->Add("x_position_in_world_units", 1.0 * i);
+        record->Add("y_position_in_world_units", 2.0 * i);
+        record->Add("z_position_in_world_units", 3.0 * i);
+        root.Add("telemetry_record_" + std::to_string(i), record);
+    }
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunArenaBenchmarks()
+{
+    bench::Print(bench::Run("build + destroy 100k nodes, heap (docs)", 1, [] {
+        auto root = std::make_shared<cereal::JsonObject>();
+        Build(*root);
+        return size_t{ 0 };
+    }));
+
+    bench::Print(bench::Run("build + destroy 100k nodes, JsonArena (docs)", 1, [] {
+        cereal::JsonArena arena(1024 * 1024);
+        auto              root = arena.MakeObject();
+        Build(*root);
+        return size_t{ 0 };
+    }));
+
+    cereal::JsonObject source;
+    Build(source);
+    const std::string json = source.ToString();
+
+    bench::Print(bench::Run("parse + destroy 100k nodes, heap (docs)", 1, [&] {
+        const cereal::JsonObject doc = cereal::JsonObject::Parse(json);
+        DoNotOptimize(doc);
+        return json.size();
+    }));
+
+    bench::Print(bench::Run("parse + destroy 100k nodes, JsonArena (docs)", 1, [&] {
+        cereal::JsonArena arena(json.size() * 2);
+        const auto        doc = arena.Parse(json);
+        DoNotOptimize(doc);
+        return json.size();
+    }));
+}
+
+} // namespace bench
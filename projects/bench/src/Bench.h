@@ -0,0 +1,155 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Bench.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench
+{
+
+// Keeps the optimizer from throwing away a result we only computed to time it
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Everything allocated through operator new since the program started, on any thread. Counted by Allocations.cpp
+struct AllocationCount
+{
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+[[nodiscard]] AllocationCount Allocations();
+
+struct Result
+{
+    std::string name;
+    size_t      items      = 0;
+    size_t      bytes      = 0;
+    double      seconds    = 0.0;
+    size_t      iterations = 0;
+
+    // Per call to fn
+    double p50Seconds     = 0.0;
+    double p99Seconds     = 0.0;
+    double allocations    = 0.0;
+    double allocatedBytes = 0.0;
+
+    [[nodiscard]] double ItemsPerSecond() const { return static_cast<double>(items) / seconds; }
+    [[nodiscard]] double MegabytesPerSecond() const { return static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds; }
+};
+
+// Every result printed so far, in order, for Main to write out
+inline std::vector<Result>& Results()
+{
+    static std::vector<Result> results;
+    return results;
+}
+
+// Calls fn repeatedly for at least minSeconds. fn returns the number of bytes it produced (0 if that is meaningless).
+//
+// The time of every call is kept for percentiles. Past a fixed number of calls only every other one is kept, then
+// every fourth and so on, so the timing loop itself never allocates and doesn't show up in the allocation counts
+template<typename Fn>
+Result Run(const std::string_view name, const size_t itemsPerCall, Fn&& fn, const double minSeconds = 0.5)
+{
+    using Clock = std::chrono::steady_clock;
+
+    fn(); // warm up caches and any buffers fn reuses
+
+    Result              result{ std::string(name) };
+    std::vector<double> laps(16 * 1024);
+    size_t              recorded = 0;
+    size_t              stride   = 1;
+
+    const AllocationCount before = Allocations();
+    const auto            start  = Clock::now();
+    auto                  lap    = start;
+    do
+    {
+        result.bytes += fn();
+        result.items += itemsPerCall;
+
+        const auto now = Clock::now();
+        if (result.iterations % stride == 0)
+        {
+            if (recorded == laps.size())
+            {
+                for (size_t i = 0; i < laps.size() / 2; ++i)
+                {
+                    laps[i] = laps[i * 2];
+                }
+                recorded = laps.size() / 2;
+                stride *= 2;
+            }
+            laps[recorded++] = std::chrono::duration<double>(now - lap).count();
+        }
+        lap = now;
+
+        ++result.iterations;
+        result.seconds = std::chrono::duration<double>(now - start).count();
+    } while (result.seconds < minSeconds);
+    const AllocationCount after = Allocations();
+
+    const auto iterations = static_cast<double>(result.iterations);
+    result.allocations    = static_cast<double>(after.count - before.count) / iterations;
+    result.allocatedBytes = static_cast<double>(after.bytes - before.bytes) / iterations;
+
+    std::sort(laps.begin(), laps.begin() + static_cast<std::ptrdiff_t>(recorded));
+    result.p50Seconds = laps[(recorded - 1) / 2];
+    result.p99Seconds = laps[(recorded - 1) * 99 / 100];
+
+    return result;
+}
+
+inline void Print(const Result& result)
+{
+    std::printf("%-48.*s %12.0f items/s", static_cast<int>(result.name.size()), result.name.data(), result.ItemsPerSecond());
+    if (result.bytes)
+    {
+        std::printf(" %10.1f MB/s", result.MegabytesPerSecond());
+    } else
+    {
+        std::printf(" %15s", "");
+    }
+    std::printf("  p50 %10.2f us  p99 %10.2f us %10.1f allocs\n", result.p50Seconds * 1e6, result.p99Seconds * 1e6,
+                result.allocations);
+
+    Results().push_back(result);
+}
+
+} // namespace bench
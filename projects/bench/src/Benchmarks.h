@@ -0,0 +1,48 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Benchmarks.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+namespace bench
+{
+
+void RunNumberBenchmarks();
+void RunEscapeBenchmarks();
+void RunParseBenchmarks();
+void RunArenaBenchmarks();
+void RunDomBenchmarks();
+void RunMemberBenchmarks();
+void RunReflectBenchmarks();
+void RunDeserializeBenchmarks();
+void RunBinaryBenchmarks();
+void RunParallelBenchmarks();
+void RunNdjsonBenchmarks();
+void RunSymbolBenchmarks();
+void RunLookupBenchmarks();
+void RunDocumentBenchmarks();
+void RunIncrementalBenchmarks();
+void RunLazyBenchmarks();
+void RunSnapshotBenchmarks();
+void RunBuilderBenchmarks();
+
+} // namespace bench
@@ -0,0 +1,185 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Cereal.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Records = 100'000;
+constexpr size_t Samples = 1'000'000;
+
+struct Vector2
+{
+    float x = 0.0f;
+    float y = 0.0f;
+
+    CEREAL_DESCRIBE(Vector2, x, y)
+};
+
+struct Vector3
+{
+    double  x = 0.0;
+    double  y = 0.0;
+    double  z = 0.0;
+    Vector2 pos;
+
+    CEREAL_DESCRIBE(Vector3, x, y, z, pos)
+};
+
+struct Records3
+{
+    std::vector<Vector3> records;
+
+    CEREAL_DESCRIBE(Records3, records)
+};
+
+struct Series
+{
+    std::vector<double> samples;
+    std::vector<int>    counts;
+
+    CEREAL_DESCRIBE(Series, samples, counts)
+};
+
+Records3 MakeRecords()
+{
+    Records3 document;
+    document.records.resize(Records);
+    for (size_t i = 0; i < Records; ++i)
+    {
+        Vector3& record = document.records[i];
+        record.x        = 0.25 * static_cast<double>(i) + 0.125;
+        record.y        = 0.5 * static_cast<double>(i) + 0.25;
+        record.z        = 1.5 * static_cast<double>(i) + 0.75;
+        record.pos.x    = static_cast<float>(i % 1000) + 0.5f;
+        record.pos.y    = 1.25f;
+    }
+    return document;
+}
+
+Series MakeSeries()
+{
+    Series series;
+    series.samples.resize(Samples);
+    series.counts.resize(Samples);
+    for (size_t i = 0; i < Samples; ++i)
+    {
+        series.samples[i] = static_cast<double>(i) * 0.001 + 0.3;
+        series.counts[i]  = static_cast<int>(i * 7 % 100'000);
+    }
+    return series;
+}
+
+const char* FormatName(const cereal::BinaryFormat format)
+{
+    return format == cereal::BinaryFormat::Cbor ? "CBOR" : "MessagePack";
+}
+
+// Times writing and reading value as json and in both binary formats, and prints how large each encoding is
+template<typename T>
+void Compare(const char* name, const T& value, const size_t items)
+{
+    using cereal::BinaryFormat;
+
+    const std::string json        = cereal::Serialize(value);
+    const std::string messagePack = cereal::SerializeBinary(value, BinaryFormat::MessagePack);
+    const std::string cbor        = cereal::SerializeBinary(value, BinaryFormat::Cbor);
+    std::printf("%s size: json %zu bytes, MessagePack %zu (%.2fx smaller), CBOR %zu (%.2fx smaller)\n", name, json.size(),
+                messagePack.size(), static_cast<double>(json.size()) / static_cast<double>(messagePack.size()), cbor.size(),
+                static_cast<double>(json.size()) / static_cast<double>(cbor.size()));
+
+    std::string out;
+    T           read;
+    bench::Print(bench::Run(std::string(name) + " write json", items, [&] {
+        out.clear();
+        cereal::Serializer<T>::Write(out, value);
+        return out.size();
+    }));
+    bench::Print(bench::Run(std::string(name) + " read json", items, [&] {
+        cereal::Deserialize(std::string_view(json), read);
+        return json.size();
+    }));
+
+    for (const BinaryFormat format : { BinaryFormat::MessagePack, BinaryFormat::Cbor })
+    {
+        const std::string& bytes = format == BinaryFormat::Cbor ? cbor : messagePack;
+        bench::Print(bench::Run(std::string(name) + " write " + FormatName(format), items, [&] {
+            out.clear();
+            cereal::WriteBinary(out, value, format);
+            return out.size();
+        }));
+        bench::Print(bench::Run(std::string(name) + " read " + FormatName(format), items, [&] {
+            cereal::DeserializeBinary(bytes, format, read);
+            return bytes.size();
+        }));
+    }
+}
+
+// The same records as a JsonObject, plus the series as arrays, to time the DOM's own encode and decode
+void CompareDom(const Records3& records, const Series& series)
+{
+    using cereal::BinaryFormat;
+
+    cereal::JsonObject root;
+    for (size_t i = 0; i < Records / 10; ++i)
+    {
+        const Vector3& record = records.records[i];
+
+        auto pos = root.CreateObject();
+        pos->Add("x", record.pos.x);
+        pos->Add("y", record.pos.y);
+
+        auto child = root.CreateObject();
+        child->Add("x", record.x);
+        child->Add("y", record.y);
+        child->Add("z", record.z);
+        child->Add("pos", std::move(pos));
+        root.Add("r" + std::to_string(i), std::move(child));
+    }
+    root.Add("samples", series.samples);
+    root.Add("counts", series.counts);
+
+    const std::string json = root.ToString();
+    std::printf("JsonObject size: json %zu bytes, MessagePack %zu, CBOR %zu\n", json.size(),
+                root.ToBinary(BinaryFormat::MessagePack).size(), root.ToBinary(BinaryFormat::Cbor).size());
+
+    bench::Print(bench::Run("JsonObject write json (documents)", 1, [&] { return root.ToString().size(); }));
+    bench::Print(bench::Run("JsonObject parse json (documents)", 1, [&] {
+        bench::DoNotOptimize(cereal::JsonObject::Parse(json));
+        return json.size();
+    }));
+
+    for (const BinaryFormat format : { BinaryFormat::MessagePack, BinaryFormat::Cbor })
+    {
+        const std::string bytes = root.ToBinary(format);
+        bench::Print(bench::Run(std::string("JsonObject write ") + FormatName(format) + " (documents)", 1,
+                                [&] { return root.ToBinary(format).size(); }));
+        bench::Print(bench::Run(std::string("JsonObject read ") + FormatName(format) + " (documents)", 1, [&] {
+            bench::DoNotOptimize(cereal::JsonObject::FromBinary(bytes, format));
+            return bytes.size();
+        }));
+    }
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunBinaryBenchmarks()
+{
+    const Records3 records = MakeRecords();
+    const Series   series  = MakeSeries();
+
+    Compare("Vector3 records", records, Records);
+    Compare("Series numbers", series, Samples * 2);
+    CompareDom(records, series);
+}
+
+} // namespace bench
@@ -0,0 +1,106 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Builder.h"
+#include "cereal/Json.h"
+#include "cereal/ThreadPool.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Members = 20'000;
+
+// Names for every member, made up front so only the inserts are measured
+std::vector<std::string> MakeKeys()
+{
+    std::vector<std::string> keys;
+    keys.reserve(Members);
+    for (size_t i = 0; i < Members; ++i)
+    {
+        keys.push_back("metric_" + std::to_string(i));
+    }
+    return keys;
+}
+
+size_t SliceStart(const size_t slice, const size_t slices)
+{
+    return Members * slice / slices;
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunBuilderBenchmarks()
+{
+    const std::vector<std::string> keys = MakeKeys();
+
+    // Powers of two up to the machine's thread count, and always at least 2 so contention itself is measured
+    const unsigned maxThreads = (std::max)(2u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        cereal::ThreadPool pool(threads);
+
+        // What producers do today: one JsonObject behind one mutex
+        const std::string locked = "JsonObject + global mutex, " + std::to_string(threads) + "t (members)";
+        bench::Print(bench::Run(locked, Members, [&] {
+            cereal::JsonObject root;
+            std::mutex         mutex;
+            pool.ForEach(threads, [&](const size_t slice) {
+                for (size_t i = SliceStart(slice, threads); i < SliceStart(slice + 1, threads); ++i)
+                {
+                    std::lock_guard lock(mutex);
+                    root.Add(keys[i], static_cast<double>(i) * 0.5);
+                }
+            });
+            return root.GetValues().size() * sizeof(double);
+        }));
+
+        const std::string sharded = "JsonBuilder, " + std::to_string(threads) + "t (members)";
+        bench::Print(bench::Run(sharded, Members, [&] {
+            cereal::JsonBuilder builder;
+            pool.ForEach(threads, [&](const size_t slice) {
+                for (size_t i = SliceStart(slice, threads); i < SliceStart(slice + 1, threads); ++i)
+                {
+                    builder.Add(keys[i], static_cast<double>(i) * 0.5);
+                }
+            });
+            return builder.Size() * sizeof(double);
+        }));
+    }
+
+    {
+        cereal::JsonBuilder builder;
+        for (size_t i = 0; i < Members; ++i)
+        {
+            builder.Add(keys[i], static_cast<double>(i) * 0.5);
+        }
+
+        bench::Print(bench::Run("JsonBuilder ToString, 20k members (docs)", 1, [&] {
+            const std::string out = builder.ToString();
+            return out.size();
+        }));
+    }
+
+    {
+        bench::Print(bench::Run("JsonBuilder Freeze, 20k members (docs)", 1, [&] {
+            cereal::JsonBuilder builder;
+            for (size_t i = 0; i < Members; ++i)
+            {
+                builder.Add(keys[i], static_cast<double>(i) * 0.5);
+            }
+            const cereal::JsonObject frozen = builder.Freeze();
+            return frozen.GetValues().size() * sizeof(double);
+        }));
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,88 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Cereal.h"
+
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Records = 100'000;
+
+struct Vector2
+{
+    float x = 0.0f;
+    float y = 0.0f;
+
+    CEREAL_DESCRIBE(Vector2, x, y)
+};
+
+struct Vector3
+{
+    double  x = 0.0;
+    double  y = 0.0;
+    double  z = 0.0;
+    Vector2 pos;
+
+    CEREAL_DESCRIBE(Vector3, x, y, z, pos)
+};
+
+struct Document
+{
+    std::vector<Vector3> records;
+
+    CEREAL_DESCRIBE(Document, records)
+};
+
+// None of the values are whole numbers, so the JsonObject side reads every one of them as a double
+std::string MakeDocument()
+{
+    Document document;
+    document.records.resize(Records);
+    for (size_t i = 0; i < Records; ++i)
+    {
+        Vector3& record = document.records[i];
+        record.x        = 0.25 * static_cast<double>(i) + 0.125;
+        record.y        = 0.5 * static_cast<double>(i) + 0.25;
+        record.z        = 1.5 * static_cast<double>(i) + 0.75;
+        record.pos.x    = static_cast<float>(i % 1000) + 0.5f;
+        record.pos.y    = 1.25f;
+    }
+    return cereal::Serialize(document);
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunDeserializeBenchmarks()
+{
+    const std::string json = MakeDocument();
+    Document          document;
+
+    bench::Print(bench::Run("Vector3 via JsonObject::Parse + Get (records)", Records, [&] {
+        const cereal::JsonObject root = cereal::JsonObject::Parse(json);
+        document.records.clear();
+        for (const auto& child : root.GetSpan<std::shared_ptr<cereal::JsonObject>>("records"))
+        {
+            const auto pos = child->Get<std::shared_ptr<cereal::JsonObject>>("pos");
+            document.records.push_back({ child->Get<double>("x"),
+                                         child->Get<double>("y"),
+                                         child->Get<double>("z"),
+                                         { static_cast<float>(pos->Get<double>("x")), static_cast<float>(pos->Get<double>("y")) } });
+        }
+        return json.size();
+    }));
+
+    bench::Print(bench::Run("Vector3 via cereal::Deserialize (records)", Records, [&] {
+        cereal::Deserialize(std::string_view(json), document);
+        return json.size();
+    }));
+}
+
+} // namespace bench
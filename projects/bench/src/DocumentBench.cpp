@@ -0,0 +1,100 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+#include "Documents.h"
+
+#include "cereal/Json.h"
+
+#include <cstdio>
+#include <string>
+
+namespace
+{
+
+constexpr const char* SuiteFile = "document_suite.json";
+
+// Looks every member up by its key, descending into nested objects through GetObject
+size_t LookUpEveryMember(const cereal::JsonObject& object)
+{
+    size_t found = 0;
+    for (const auto& [key, value] : object.GetValues())
+    {
+        const std::string_view name = key;
+        found += object.GetValues().find(name) != object.GetValues().end();
+        if (value.GetType() == cereal::JsonType::Object)
+        {
+            found += LookUpEveryMember(object.GetObject(name));
+        }
+    }
+    return found;
+}
+
+std::string Label(const bench::Document& document, const std::string_view what)
+{
+    return std::string(document.name) + ": " + std::string(what);
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunDocumentBenchmarks()
+{
+    for (const Document& document : MakeDocuments())
+    {
+        const std::string text   = document.json.ToString();
+        const std::string pretty = document.json.ToString(true);
+        std::printf("%.*s document: %zu members, %.2f MB compact, %.2f MB pretty\n", static_cast<int>(document.name.size()),
+                    document.name.data(), document.members,
+                    static_cast<double>(text.size()) / (1024.0 * 1024.0),
+                    static_cast<double>(pretty.size()) / (1024.0 * 1024.0));
+
+        std::string out;
+        bench::Print(bench::Run(Label(document, "serialize (docs)"), 1, [&] {
+            out.clear();
+            cereal::JsonWriter writer(out);
+            document.json.Write(writer);
+            return out.size();
+        }));
+
+        bench::Print(bench::Run(Label(document, "serialize pretty (docs)"), 1, [&] {
+            out.clear();
+            cereal::JsonWriter writer(out);
+            document.json.Write(writer, true);
+            return out.size();
+        }));
+
+        bench::Print(bench::Run(Label(document, "serialize canonical (docs)"), 1, [&] {
+            out.clear();
+            cereal::JsonWriter writer(out);
+            document.json.WriteCanonical(writer);
+            return out.size();
+        }));
+
+        bench::Print(bench::Run(Label(document, "parse (docs)"), 1, [&] {
+            const cereal::JsonObject parsed = cereal::JsonObject::Parse(text);
+            DoNotOptimize(parsed);
+            return text.size();
+        }));
+
+        bench::Print(bench::Run(Label(document, "parse pretty (docs)"), 1, [&] {
+            const cereal::JsonObject parsed = cereal::JsonObject::Parse(pretty);
+            DoNotOptimize(parsed);
+            return pretty.size();
+        }));
+
+        bench::Print(bench::Run(Label(document, "look up every member (lookups)"), document.members, [&] {
+            DoNotOptimize(LookUpEveryMember(document.json));
+            return size_t{ 0 };
+        }));
+
+        bench::Print(bench::Run(Label(document, "print to file (docs)"), 1, [&] {
+            document.json.PrintToFile(SuiteFile);
+            return text.size();
+        }));
+    }
+
+    std::remove(SuiteFile);
+}
+
+} // namespace bench
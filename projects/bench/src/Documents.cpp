@@ -0,0 +1,103 @@
+#include "Documents.h"
+
+#include <string>
+
+namespace bench
+{
+
+Document MakeWideDocument(const size_t members)
+{
+    Document document{ "wide", {} };
+    for (size_t i = 0; i < members; ++i)
+    {
+        const std::string key = "member" + std::to_string(i);
+        switch (i % 4)
+        {
+        case 0: document.json.Add(key, static_cast<int>(i * 7919 % 100'000)); break;
+        case 1: document.json.Add(key, 0.25 * static_cast<double>(i)); break;
+        case 2: document.json.Add(key, i % 3 == 0); break;
+        default: document.json.Add(key, "value" + std::to_string(i % 97)); break;
+        }
+    }
+    document.members = members;
+    return document;
+}
+
+Document MakeDeepDocument(const size_t branches, const size_t depth)
+{
+    Document document{ "deep", {} };
+    for (size_t branch = 0; branch < branches; ++branch)
+    {
+        // Built from the innermost level out, so every level is complete before it is added to its parent
+        std::shared_ptr<cereal::JsonObject> node;
+        for (size_t level = depth; level-- > 0;)
+        {
+            auto parent = document.json.CreateObject();
+            parent->Add("level", static_cast<int>(level));
+            parent->Add("name", "node");
+            if (node)
+            {
+                parent->Add("next", node);
+            }
+            node = std::move(parent);
+        }
+        document.json.Add("branch" + std::to_string(branch), node);
+    }
+    document.members = branches + branches * (depth * 3 - 1);
+    return document;
+}
+
+Document MakeFloatDocument(const size_t arrays, const size_t length)
+{
+    Document document{ "floats", {} };
+    for (size_t i = 0; i < arrays; ++i)
+    {
+        std::vector<float> values(length);
+        for (size_t j = 0; j < length; ++j)
+        {
+            values[j] = static_cast<float>(i) + static_cast<float>(j) * 0.001f;
+        }
+        document.json.Add("samples" + std::to_string(i), std::move(values));
+    }
+    document.members = arrays;
+    return document;
+}
+
+Document MakeStringDocument(const size_t members)
+{
+    // Quotes, a backslash, control characters and 2, 3 and 4 byte utf-8 sequences between runs of plain text
+    constexpr std::string_view pieces[] = {
+        "The quick brown fox jumps over the lazy dog. ",
+        "She said \"hello\" and left. ",
+        "C:\\path\\to\\file ",
+        "tab\there\nnew line ",
+        "caf\xC3\xA9 na\xC3\xAFve ",
+        "\xE2\x82\xAC 42 \xE2\x80\x94 ",
+        "\xF0\x9F\x98\x80 ",
+    };
+
+    Document document{ "strings", {} };
+    for (size_t i = 0; i < members; ++i)
+    {
+        std::string text;
+        for (size_t j = 0; j < 8; ++j)
+        {
+            text += pieces[(i + j * 3) % std::size(pieces)];
+        }
+        document.json.Add("text" + std::to_string(i), text);
+    }
+    document.members = members;
+    return document;
+}
+
+std::vector<Document> MakeDocuments()
+{
+    std::vector<Document> documents;
+    documents.push_back(MakeWideDocument());
+    documents.push_back(MakeDeepDocument());
+    documents.push_back(MakeFloatDocument());
+    documents.push_back(MakeStringDocument());
+    return documents;
+}
+
+} // namespace bench
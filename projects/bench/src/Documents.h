@@ -0,0 +1,34 @@
+#pragma once
+
+#include "cereal/Json.h"
+
+#include <string_view>
+#include <vector>
+
+namespace bench
+{
+
+// The shapes the document suite measures. Every generator is deterministic, so two runs of the suite, on two commits,
+// see exactly the same input
+struct Document
+{
+    std::string_view   name;
+    cereal::JsonObject json;
+    size_t             members = 0; // every member of every object, counted once
+};
+
+// One object with many scalar members: ints, doubles, bools and short strings
+[[nodiscard]] Document MakeWideDocument(size_t members = 20'000);
+
+// branches chains of objects nested depth levels deep, each level with a couple of scalars next to the next level
+[[nodiscard]] Document MakeDeepDocument(size_t branches = 64, size_t depth = 256);
+
+// Long float arrays, the shape of vertex and sample data
+[[nodiscard]] Document MakeFloatDocument(size_t arrays = 64, size_t length = 4096);
+
+// Long strings full of quotes, control characters and multi byte utf-8
+[[nodiscard]] Document MakeStringDocument(size_t members = 5'000);
+
+[[nodiscard]] std::vector<Document> MakeDocuments();
+
+} // namespace bench
@@ -0,0 +1,102 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Json.h"
+
+#include <cstdio>
+#include <memory_resource>
+
+namespace
+{
+
+constexpr size_t Records = 10'000;
+
+// Forwards to the default resource and keeps count of what is currently allocated through it
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t bytes       = 0;
+    size_t allocations = 0;
+
+private:
+    void* do_allocate(const size_t size, const size_t alignment) override
+    {
+        bytes += size;
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+
+    void do_deallocate(void* p, const size_t size, const size_t alignment) override
+    {
+        bytes -= size;
+        --allocations;
+        std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Every record is 8 nodes: the record itself, 4 scalars, the nested object and its 2 members
+void Build(cereal::JsonObject& root)
+{
+    for (size_t i = 0; i < Records; ++i)
+    {
+        auto record = root.CreateObject();
+        record->Add("id", static_cast<int>(i));
+        record->Add("value", 0.5 * i);
+        record->Add("flag", i % 2 == 0);
+        record->Add("name", "item");
+
+        auto pos = record->CreateObject();
+        pos->Add("x", 1.5f);
+        pos->Add("y", 2.5f);
+        record->Add("pos", pos);
+
+        root.Add("r" + std::to_string(i), record);
+    }
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunDomBenchmarks()
+{
+    {
+        CountingResource   counter;
+        cereal::JsonObject root(&counter);
+        Build(root);
+
+        const size_t nodes = Records * 8;
+        std::printf("sizeof(JsonValue) %zu bytes, %.1f bytes and %.2f allocations per node (excluding string contents)\n",
+                    sizeof(cereal::JsonObject::JsonValue), static_cast<double>(counter.bytes) / nodes,
+                    static_cast<double>(counter.allocations) / nodes);
+    }
+
+    cereal::JsonObject root;
+    Build(root);
+
+    std::string out;
+    bench::Print(bench::Run("write 80k node document (nodes)", Records * 8, [&] {
+        out.clear();
+        cereal::JsonWriter writer(out);
+        root.Write(writer);
+        return out.size();
+    }));
+
+    bench::Print(bench::Run("typed Get of every value (nodes)", Records * 6, [&] {
+        double sum = 0;
+        for (const auto& [key, value] : root.GetValues())
+        {
+            const cereal::JsonObject& record = root.GetObject(std::string(key));
+            sum += record.Get<int>("id") + record.Get<double>("value") + record.Get<bool>("flag");
+            sum += static_cast<double>(record.Get<std::string>("name").size());
+            sum += record.GetObject("pos").Get<float>("x") + record.GetObject("pos").Get<float>("y");
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+}
+
+} // namespace bench
@@ -0,0 +1,98 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Escape.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// The obvious one character at a time escape loop, kept as the baseline
+void NaiveEscape(std::string& out, const std::string_view text)
+{
+    constexpr char hex[] = "0123456789abcdef";
+
+    out += '"';
+    for (const char ch : text)
+    {
+        const auto c = static_cast<unsigned char>(ch);
+        switch (c)
+        {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c < 0x20)
+            {
+                out += "\\u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xF];
+            } else
+            {
+                out += ch;
+            }
+        }
+    }
+    out += '"';
+}
+
+// escapeEvery == 0 produces strings that need no escaping at all
+std::vector<std::string> MakeStrings(const size_t escapeEvery)
+{
+    std::mt19937 rng(42);
+
+    std::vector<std::string> strings(10'000);
+    for (std::string& s : strings)
+    {
+        s.resize(16 + rng() % 112);
+        for (size_t i = 0; i < s.size(); ++i)
+        {
+            s[i] = escapeEvery && i % escapeEvery == escapeEvery - 1 ? "\"\\\n\t"[rng() % 4] : static_cast<char>('a' + rng() % 26);
+        }
+    }
+    return strings;
+}
+
+void Compare(const std::string_view naiveName, const std::string_view simdName, const size_t escapeEvery)
+{
+    const std::vector<std::string> strings = MakeStrings(escapeEvery);
+    std::string                    out;
+
+    bench::Print(bench::Run(naiveName, strings.size(), [&] {
+        out.clear();
+        for (const std::string& s : strings)
+        {
+            NaiveEscape(out, s);
+        }
+        return out.size();
+    }));
+
+    bench::Print(bench::Run(simdName, strings.size(), [&] {
+        out.clear();
+        for (const std::string& s : strings)
+        {
+            cereal::WriteEscapedString(out, s);
+        }
+        return out.size();
+    }));
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunEscapeBenchmarks()
+{
+    Compare("escape clean text  naive", "escape clean text  WriteEscapedString", 0);
+    Compare("escape 1 in 64     naive", "escape 1 in 64     WriteEscapedString", 64);
+    Compare("escape 1 in 8      naive", "escape 1 in 8      WriteEscapedString", 8);
+}
+
+} // namespace bench
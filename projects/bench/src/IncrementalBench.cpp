@@ -0,0 +1,98 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Json.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Entities       = 2'000;
+constexpr size_t ChangedPerTick = 16;
+
+// A game state style document: a few thousand entities, of which only a handful move between ticks
+struct State
+{
+    cereal::JsonObject                               root;
+    std::vector<std::shared_ptr<cereal::JsonObject>> positions;
+};
+
+State MakeState()
+{
+    State state;
+    auto  entities = state.root.CreateObject();
+    for (size_t i = 0; i < Entities; ++i)
+    {
+        auto entity = state.root.CreateObject();
+        entity->Add("id", static_cast<int>(i));
+        entity->Add("name", "entity_" + std::to_string(i));
+        entity->Add("health", 100.0);
+        entity->Add("alive", true);
+
+        auto pos = entity->CreateObject();
+        pos->Add("x", 0.5 * static_cast<double>(i));
+        pos->Add("y", 1.0);
+        pos->Add("z", -0.25 * static_cast<double>(i));
+        entity->Add("pos", pos);
+        state.positions.push_back(pos);
+
+        entities->Add("e" + std::to_string(i), entity);
+    }
+    state.root.Add("tick", 0);
+    state.root.Add("entities", entities);
+    return state;
+}
+
+// Moves a few entities and bumps the tick, the way one frame of a simulation would
+void Tick(State& state, size_t& tick)
+{
+    ++tick;
+    for (size_t i = 0; i < ChangedPerTick; ++i)
+    {
+        (*state.positions[(tick * 131 + i * 977) % Entities])["x"] = static_cast<double>(tick) + 0.5;
+    }
+    state.root["tick"] = static_cast<int>(tick);
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunIncrementalBenchmarks()
+{
+    {
+        State  state = MakeState();
+        size_t tick  = 0;
+        bench::Print(bench::Run("ToString, 16 of 2000 moved (ticks)", 1, [&] {
+            Tick(state, tick);
+            const std::string out = state.root.ToString();
+            return out.size();
+        }));
+    }
+
+    {
+        State  state = MakeState();
+        size_t tick  = 0;
+        bench::Print(bench::Run("ToStringCached, 16 of 2000 moved (ticks)", 1, [&] {
+            Tick(state, tick);
+            const std::string out = state.root.ToStringCached();
+            return out.size();
+        }));
+    }
+
+    {
+        State  state = MakeState();
+        size_t tick  = 0;
+        bench::Print(bench::Run("ToStringCached pretty, 16 of 2000 moved (ticks)", 1, [&] {
+            Tick(state, tick);
+            const std::string out = state.root.ToStringCached(true);
+            return out.size();
+        }));
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,72 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+#include "Documents.h"
+
+#include "cereal/Json.h"
+#include "cereal/Lazy.h"
+
+#include <string>
+#include <string_view>
+
+namespace
+{
+
+// One member of each type, spread across the document, the way a handler reads a few fields out of a large request
+constexpr std::string_view Fields[] = { "member4", "member10001", "member15002", "member19999" };
+
+} // namespace
+
+namespace bench
+{
+
+void RunLazyBenchmarks()
+{
+    const std::string wide = MakeWideDocument().json.ToString();
+
+    bench::Print(bench::Run("wide, Parse and read 4 members (docs)", 1, [&] {
+        const cereal::JsonObject json = cereal::JsonObject::Parse(wide);
+        size_t                   sum  = static_cast<size_t>(json.Get<int>(Fields[0]));
+        sum += static_cast<size_t>(json.Get<double>(Fields[1]));
+        sum += json.Get<bool>(Fields[2]);
+        sum += json.Get<std::string>(Fields[3]).size();
+        DoNotOptimize(sum);
+        return wide.size();
+    }));
+
+    bench::Print(bench::Run("wide, LazyDocument and read 4 members (docs)", 1, [&] {
+        const cereal::LazyDocument json = cereal::LazyDocument::View(wide);
+        size_t                     sum  = static_cast<size_t>(json.Get<int>(Fields[0]));
+        sum += static_cast<size_t>(json.Get<double>(Fields[1]));
+        sum += json.Get<bool>(Fields[2]);
+        sum += json.Get<std::string_view>(Fields[3]).size();
+        DoNotOptimize(sum);
+        return wide.size();
+    }));
+
+    // Every branch is 256 levels deep, and all but the last one are jumped over whole
+    const std::string deep = MakeDeepDocument().json.ToString();
+
+    bench::Print(bench::Run("deep, Parse and read one leaf (docs)", 1, [&] {
+        const cereal::JsonObject json = cereal::JsonObject::Parse(deep);
+        DoNotOptimize(json.GetObject("branch63").GetObject("next").Get<int>("level"));
+        return deep.size();
+    }));
+
+    bench::Print(bench::Run("deep, LazyDocument and read one leaf (docs)", 1, [&] {
+        const cereal::LazyDocument json = cereal::LazyDocument::View(deep);
+        DoNotOptimize(json.GetObject("branch63").GetObject("next").Get<int>("level"));
+        return deep.size();
+    }));
+
+    const cereal::LazyDocument lazy = cereal::LazyDocument::View(wide);
+    bench::Print(bench::Run("wide, read 4 members of an open document", 4, [&] {
+        size_t sum = static_cast<size_t>(lazy.Get<int>(Fields[0]));
+        sum += static_cast<size_t>(lazy.Get<double>(Fields[1]));
+        sum += lazy.Get<bool>(Fields[2]);
+        sum += lazy.Get<std::string_view>(Fields[3]).size();
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+}
+
+} // namespace bench
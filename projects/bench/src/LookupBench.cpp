@@ -0,0 +1,180 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Json.h"
+#include "cereal/Pointer.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Rounds = 100'000;
+
+// Shaped like the test app's document, with enough filler on the root that it is searched through its hash index
+cereal::JsonObject MakeDocument()
+{
+    cereal::JsonObject root;
+    for (int i = 0; i < 32; ++i)
+    {
+        root.Add("filler_" + std::to_string(i), i);
+    }
+
+    auto coord = std::make_shared<cereal::JsonObject>();
+    coord->Add("x", 1.0);
+    coord->Add("y", 2.0);
+    coord->Add("z", 3.0);
+
+    auto history = std::make_shared<cereal::JsonObject>();
+    history->Add("most_recent_sample_value", 4.0);
+
+    auto child = std::make_shared<cereal::JsonObject>();
+    child->Add("name", "John Doe");
+    child->Add("3dcoord", coord);
+    child->Add("telemetry_position_history", history);
+    child->Add("samples", std::vector<double>(64, 0.5));
+    root.Add("child", child);
+    return root;
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunLookupBenchmarks()
+{
+    cereal::JsonObject        document = MakeDocument();
+    const cereal::JsonObject& json     = document;
+
+    bench::Print(bench::Run("json[\"child\"][\"3dcoord\"][\"x\"] (lookups)", Rounds * 3, [&] {
+        double sum = 0;
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            const double x = json["child"]["3dcoord"]["x"];
+            sum += x;
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    bench::Print(bench::Run("GetObject chain, short keys (lookups)", Rounds * 3, [&] {
+        double sum = 0;
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            sum += json.GetObject("child").GetObject("3dcoord").Get<double>("x");
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    bench::Print(bench::Run("GetObject chain, long keys (lookups)", Rounds * 3, [&] {
+        double sum = 0;
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            sum += json.GetObject("child")
+                       .GetObject("telemetry_position_history")
+                       .Get<double>("most_recent_sample_value");
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    const cereal::HashedKey child("child");
+    const cereal::HashedKey coord("3dcoord");
+    const cereal::HashedKey x("x");
+    bench::Print(bench::Run("json[child][coord][x], hashed keys (lookups)", Rounds * 3, [&] {
+        double sum = 0;
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            const double value = json[child][coord][x];
+            sum += value;
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    const cereal::Symbol& childSymbol = cereal::Intern("child");
+    const cereal::Symbol& coordSymbol = cereal::Intern("3dcoord");
+    const cereal::Symbol& xSymbol     = cereal::Intern("x");
+    bench::Print(bench::Run("json[child][coord][x], symbols (lookups)", Rounds * 3, [&] {
+        double sum = 0;
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            const double value = json[childSymbol][coordSymbol][xSymbol];
+            sum += value;
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    const cereal::JsonPointer pointer("/child/3dcoord/x");
+    bench::Print(bench::Run("JsonPointer /child/3dcoord/x (lookups)", Rounds * 3, [&] {
+        double sum = 0;
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            sum += pointer.Get<double>(json);
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    const cereal::JsonPointer element("/child/samples/17");
+    bench::Print(bench::Run("JsonPointer /child/samples/17 (lookups)", Rounds * 3, [&] {
+        double sum = 0;
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            sum += element.Get<double>(json);
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    bench::Print(bench::Run("x, y and z, proxy chains (lookups)", Rounds * 9, [&] {
+        double sum = 0;
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            const double x = json["child"]["3dcoord"]["x"];
+            const double y = json["child"]["3dcoord"]["y"];
+            const double z = json["child"]["3dcoord"]["z"];
+            sum += x + y + z;
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    cereal::JsonPointerSet coordinates;
+    coordinates.Add("/child/3dcoord/x");
+    coordinates.Add("/child/3dcoord/y");
+    coordinates.Add("/child/3dcoord/z");
+    std::vector<cereal::JsonTarget> targets;
+    bench::Print(bench::Run("x, y and z, JsonPointerSet (lookups)", Rounds * 9, [&] {
+        double sum = 0;
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            coordinates.Resolve(json, targets);
+            sum += targets[0].Get<double>() + targets[1].Get<double>() + targets[2].Get<double>();
+        }
+        DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    bench::Print(bench::Run("json[\"child\"][\"3dcoord\"][\"x\"] = v (lookups)", Rounds * 3, [&] {
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            document["child"]["3dcoord"]["x"] = static_cast<double>(i);
+        }
+        return size_t{ 0 };
+    }));
+
+    bench::Print(bench::Run("JsonPointer Set /child/3dcoord/x (lookups)", Rounds * 3, [&] {
+        for (size_t i = 0; i < Rounds; ++i)
+        {
+            pointer.Set(document, static_cast<double>(i));
+        }
+        return size_t{ 0 };
+    }));
+}
+
+} // namespace bench
@@ -0,0 +1,198 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Deserializer.h"
+#include "cereal/Reflect.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+struct Group
+{
+    std::string_view name;
+    void (*run)();
+};
+
+constexpr Group Groups[] = {
+    { "number", bench::RunNumberBenchmarks },
+    { "escape", bench::RunEscapeBenchmarks },
+    { "parse", bench::RunParseBenchmarks },
+    { "arena", bench::RunArenaBenchmarks },
+    { "dom", bench::RunDomBenchmarks },
+    { "member", bench::RunMemberBenchmarks },
+    { "reflect", bench::RunReflectBenchmarks },
+    { "deserialize", bench::RunDeserializeBenchmarks },
+    { "binary", bench::RunBinaryBenchmarks },
+    { "parallel", bench::RunParallelBenchmarks },
+    { "ndjson", bench::RunNdjsonBenchmarks },
+    { "symbol", bench::RunSymbolBenchmarks },
+    { "lookup", bench::RunLookupBenchmarks },
+    { "document", bench::RunDocumentBenchmarks },
+    { "incremental", bench::RunIncrementalBenchmarks },
+    { "lazy", bench::RunLazyBenchmarks },
+    { "snapshot", bench::RunSnapshotBenchmarks },
+    { "builder", bench::RunBuilderBenchmarks },
+};
+
+// One line of the --json output, and of the baseline read back by --compare
+struct Record
+{
+    std::string name;
+    double      itemsPerSecond        = 0.0;
+    double      megabytesPerSecond    = 0.0;
+    double      p50Microseconds       = 0.0;
+    double      p99Microseconds       = 0.0;
+    double      allocationsPerCall    = 0.0;
+    double      allocatedBytesPerCall = 0.0;
+
+    CEREAL_DESCRIBE(Record, name, itemsPerSecond, megabytesPerSecond, p50Microseconds, p99Microseconds,
+                    allocationsPerCall, allocatedBytesPerCall)
+};
+
+struct Options
+{
+    std::vector<std::string_view> groups;
+    const char*                   json      = nullptr;
+    const char*                   baseline  = nullptr;
+    double                        threshold = 5.0; // percent
+};
+
+void Usage()
+{
+    std::printf("usage: Bench [options] [group...]\n"
+                "  group...            only run these groups (default: all)\n"
+                "  --list              list the groups and exit\n"
+                "  --json <file>       write every result to file\n"
+                "  --compare <file>    compare against results written earlier with --json\n"
+                "  --threshold <pct>   slowdown that --compare reports as a regression (default 5)\n");
+}
+
+std::vector<Record> ToRecords(const std::vector<bench::Result>& results)
+{
+    std::vector<Record> records;
+    records.reserve(results.size());
+    for (const bench::Result& result : results)
+    {
+        records.push_back({ result.name, result.ItemsPerSecond(), result.bytes ? result.MegabytesPerSecond() : 0.0,
+                            result.p50Seconds * 1e6, result.p99Seconds * 1e6, result.allocations,
+                            result.allocatedBytes });
+    }
+    return records;
+}
+
+// Prints how every result moved against the baseline. Returns how many got slower by more than the threshold
+int Compare(const std::vector<Record>& current, const std::vector<Record>& baseline, const double threshold)
+{
+    std::unordered_map<std::string_view, const Record*> previous;
+    for (const Record& record : baseline)
+    {
+        previous.emplace(record.name, &record);
+    }
+
+    std::printf("\n%-48s %14s %14s %8s %18s\n", "compared to baseline", "before", "after", "change", "allocs");
+
+    int regressions = 0;
+    for (const Record& record : current)
+    {
+        const auto it = previous.find(record.name);
+        if (it == previous.end())
+        {
+            std::printf("%-48s %14s %12.0f/s\n", record.name.c_str(), "new", record.itemsPerSecond);
+            continue;
+        }
+
+        const Record& before = *it->second;
+        const double  change = (record.itemsPerSecond / before.itemsPerSecond - 1.0) * 100.0;
+        const bool    slower = change < -threshold;
+        regressions += slower;
+        std::printf("%-48s %12.0f/s %12.0f/s %+7.1f%% %8.1f -> %-8.1f%s\n", record.name.c_str(), before.itemsPerSecond,
+                    record.itemsPerSecond, change, before.allocationsPerCall, record.allocationsPerCall,
+                    slower ? " REGRESSION" : "");
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--list")
+        {
+            for (const Group& group : Groups)
+            {
+                std::printf("%.*s\n", static_cast<int>(group.name.size()), group.name.data());
+            }
+            return 0;
+        }
+        if ((arg == "--json" || arg == "--compare" || arg == "--threshold") && i + 1 < argc)
+        {
+            const char* value = argv[++i];
+            if (arg == "--json")
+            {
+                options.json = value;
+            } else if (arg == "--compare")
+            {
+                options.baseline = value;
+            } else
+            {
+                options.threshold = std::atof(value);
+            }
+        } else if (arg.starts_with("-"))
+        {
+            Usage();
+            return 2;
+        } else
+        {
+            options.groups.push_back(arg);
+        }
+    }
+
+    // Read up front so a bad baseline fails before minutes of benchmarking rather than after
+    std::vector<Record> baseline;
+    if (options.baseline)
+    {
+        std::ifstream file(options.baseline);
+        if (!file)
+        {
+            std::fprintf(stderr, "Could not open %s\n", options.baseline);
+            return 2;
+        }
+        std::stringstream text;
+        text << file.rdbuf();
+        baseline = cereal::Deserialize<std::vector<Record>>(text.str());
+    }
+
+    for (const Group& group : Groups)
+    {
+        if (options.groups.empty() || std::find(options.groups.begin(), options.groups.end(), group.name) != options.groups.end())
+        {
+            group.run();
+        }
+    }
+
+    const std::vector<Record> records = ToRecords(bench::Results());
+    if (options.json)
+    {
+        std::ofstream file(options.json);
+        file << cereal::Serialize(records) << '\n';
+    }
+
+    if (options.baseline)
+    {
+        return Compare(records, baseline, options.threshold) ? 1 : 0;
+    }
+}
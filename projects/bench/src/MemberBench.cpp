@@ -0,0 +1,105 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Json.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+// What JsonObject stored its members in before ValueMap
+using HashMap = std::pmr::unordered_map<std::pmr::string, cereal::JsonValue, cereal::StringHash, cereal::StringEqual>;
+
+constexpr size_t Rounds = 64; // lookups and writes are repeated to get each call well above the timer's resolution
+
+std::vector<std::string> MakeKeys(const size_t count)
+{
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < count; ++i)
+    {
+        keys.push_back("member_" + std::to_string(i));
+    }
+    return keys;
+}
+
+template<typename Map>
+void Fill(Map& map, const std::vector<std::string>& keys)
+{
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        map.try_emplace(typename Map::key_type(keys[i])).first->second = 0.5 * static_cast<double>(i);
+    }
+}
+
+template<typename Map>
+size_t WriteMembers(const Map& map, std::string& out)
+{
+    out.clear();
+    out += '{';
+    bool first = true;
+    for (const auto& [key, value] : map)
+    {
+        if (!first)
+        {
+            out += ", ";
+        }
+        cereal::WriteEscapedString(out, key);
+        out += ": ";
+        value.Write(out);
+        first = false;
+    }
+    out += '}';
+    return out.size();
+}
+
+template<typename Map>
+void RunFor(const char* mapName, const std::vector<std::string>& keys)
+{
+    Map map;
+    Fill(map, keys);
+
+    const std::string lookup = std::to_string(keys.size()) + " keys, lookup, " + mapName + " (lookups)";
+    bench::Print(bench::Run(lookup, keys.size() * Rounds, [&] {
+        double sum = 0;
+        for (size_t round = 0; round < Rounds; ++round)
+        {
+            for (const std::string& key : keys)
+            {
+                sum += map.find(key)->second.template Get<double>();
+            }
+        }
+        bench::DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    std::string       out;
+    const std::string write = std::to_string(keys.size()) + " keys, write, " + mapName + " (objects)";
+    bench::Print(bench::Run(write, Rounds, [&] {
+        size_t bytes = 0;
+        for (size_t round = 0; round < Rounds; ++round)
+        {
+            bytes += WriteMembers(map, out);
+        }
+        return bytes;
+    }));
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunMemberBenchmarks()
+{
+    for (const size_t count : { 2, 4, 8, 16, 32, 128 })
+    {
+        const std::vector<std::string> keys = MakeKeys(count);
+        RunFor<HashMap>("unordered_map", keys);
+        RunFor<cereal::ValueMap>("ValueMap", keys);
+    }
+}
+
+} // namespace bench
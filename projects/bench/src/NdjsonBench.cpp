@@ -0,0 +1,124 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Cereal.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Records = 200'000;
+
+// One telemetry event, built into a JsonObject every time it is written like a real Serializable would be
+class Event : public cereal::Serializable
+{
+public:
+    explicit Event(const size_t id) : mId(id) {}
+
+    std::shared_ptr<cereal::JsonObject> Serialize() override
+    {
+        auto object = std::make_shared<cereal::JsonObject>();
+        object->Add("id", static_cast<int>(mId));
+        object->Add("kind", mId % 3 == 0 ? "update" : "spawn");
+        object->Add("alive", mId % 5 != 0);
+        object->Add("x", 0.25 * static_cast<double>(mId));
+        object->Add("y", -1.5 * static_cast<double>(mId % 97));
+        return object;
+    }
+
+private:
+    size_t mId;
+};
+
+// A record whose Serialize fails, as when the state it describes has gone away
+class BrokenEvent : public cereal::Serializable
+{
+public:
+    std::shared_ptr<cereal::JsonObject> Serialize() override { throw std::runtime_error("event is gone"); }
+};
+
+void PrintLatency(const cereal::NdjsonStats& stats)
+{
+    std::printf("%-48s p50 %8.2f ms  p99 %8.2f ms per batch\n", "", stats.p50BatchSeconds * 1e3,
+                stats.p99BatchSeconds * 1e3);
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunNdjsonBenchmarks()
+{
+    std::vector<Event> events;
+    events.reserve(Records);
+    for (size_t i = 0; i < Records; ++i)
+    {
+        events.emplace_back(i);
+    }
+
+    const std::string path = "bench_events.ndjson";
+
+    const unsigned maxThreads = (std::max)(2u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        cereal::ThreadPool   pool(threads);
+        cereal::NdjsonWriter writer(path, pool);
+
+        const std::string name = "ndjson write 200k events, " + std::to_string(threads) + "t (records)";
+        bench::Print(bench::Run(name, Records, [&] {
+            writer.Write(events);
+            writer.Flush();
+            return 0;
+        }));
+        PrintLatency(writer.GetStats());
+    }
+
+    {
+        // Batches taken for records that throw go back to the writer, so it carries on as if they were never written
+        cereal::ThreadPool       pool(2);
+        cereal::NdjsonWriter     writer(path, pool, cereal::NdjsonWriter::DefaultBatchRecords, 2);
+        std::vector<BrokenEvent> broken(3);
+        bench::Print(bench::Run("ndjson write 200k after a failure (records)", Records, [&] {
+            try
+            {
+                writer.Write(broken);
+            } catch (const std::runtime_error&)
+            {
+            }
+            writer.Write(events);
+            writer.Flush();
+            return 0;
+        }));
+    }
+
+    {
+        cereal::ThreadPool   pool(1);
+        cereal::NdjsonWriter writer(path, pool);
+        writer.Write(events);
+    }
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        cereal::ThreadPool   pool(threads);
+        cereal::NdjsonReader reader(pool);
+
+        const std::string name = "ndjson read 200k events, " + std::to_string(threads) + "t (records)";
+        bench::Print(bench::Run(name, Records, [&] {
+            size_t count = 0;
+            reader.ReadFile(path, [&](cereal::JsonObject& record) { count += record.GetValues().size(); });
+            DoNotOptimize(count);
+            return 0;
+        }));
+        PrintLatency(reader.GetStats());
+    }
+    std::remove(path.c_str());
+}
+
+} // namespace bench
@@ -0,0 +1,129 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Serializer.h"
+
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t ValueCount = 100'000;
+
+// What SerializeItem did before it went through to_chars, kept here as the baseline
+template<typename T>
+std::string LegacyFormat(const T& value, const int precision)
+{
+    std::ostringstream oss;
+    if (precision > 0)
+    {
+        oss << std::setprecision(precision);
+    }
+    oss << value;
+    return oss.str();
+}
+
+template<typename T>
+std::vector<T> MakeValues()
+{
+    std::mt19937 rng(1234);
+
+    std::vector<T> values(ValueCount);
+    for (T& v : values)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            v = std::uniform_real_distribution<T>(-1000, 1000)(rng);
+        } else
+        {
+            v = std::uniform_int_distribution<T>(std::numeric_limits<T>::min(), std::numeric_limits<T>::max())(rng);
+        }
+    }
+    return values;
+}
+
+template<typename T>
+void Compare(const std::string_view legacyName, const int legacyPrecision, const std::string_view newName, const int precision)
+{
+    const std::vector<T> values = MakeValues<T>();
+    std::string          out;
+    out.reserve(ValueCount * 32);
+
+    bench::Print(bench::Run(legacyName, ValueCount, [&] {
+        out.clear();
+        for (const T& v : values)
+        {
+            out += LegacyFormat(v, legacyPrecision);
+            out += ", ";
+        }
+        return out.size();
+    }));
+
+    bench::Print(bench::Run(newName, ValueCount, [&] {
+        out.clear();
+        for (const T& v : values)
+        {
+            cereal::WriteNumber(out, v, precision);
+            out += ", ";
+        }
+        return out.size();
+    }));
+}
+
+// A whole array the way WriteRange used to do it, one element at a time, against the bulk kernel
+template<typename T>
+void CompareArray(const std::string_view elementName, const std::string_view bulkName)
+{
+    const std::vector<T> values = MakeValues<T>();
+    std::string          out;
+    out.reserve(ValueCount * 32);
+
+    bench::Print(bench::Run(elementName, ValueCount, [&] {
+        out.clear();
+        out += '[';
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i != 0)
+            {
+                out += ", ";
+            }
+            cereal::Serializer<T>::Write(out, values[i]);
+        }
+        out += ']';
+        return out.size();
+    }));
+
+    bench::Print(bench::Run(bulkName, ValueCount, [&] {
+        out.clear();
+        cereal::WriteSpan(out, std::span<const T>(values));
+        return out.size();
+    }));
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunNumberBenchmarks()
+{
+    constexpr int fltDigits = std::numeric_limits<float>::digits10;
+    constexpr int dblDigits = std::numeric_limits<double>::digits10;
+
+    // Fixed precision against fixed precision, then the old way of getting a value that round trips against shortest
+    Compare<float>("float  ostringstream (digits10)", fltDigits, "float  to_chars (digits10)", fltDigits);
+    Compare<float>("float  ostringstream (max_digits10)", std::numeric_limits<float>::max_digits10, "float  to_chars (shortest)", 0);
+    Compare<double>("double ostringstream (digits10)", dblDigits, "double to_chars (digits10)", dblDigits);
+    Compare<double>("double ostringstream (max_digits10)", std::numeric_limits<double>::max_digits10, "double to_chars (shortest)", 0);
+    Compare<int>("int    ostringstream", 0, "int    to_chars", 0);
+
+    CompareArray<float>("float  array, per element", "float  array, WriteSpan");
+    CompareArray<double>("double array, per element", "double array, WriteSpan");
+    CompareArray<int>("int    array, per element", "int    array, WriteSpan");
+}
+
+} // namespace bench
@@ -0,0 +1,78 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Json.h"
+#include "cereal/ThreadPool.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Records = 20'000;
+constexpr size_t Samples = 1'000'000;
+
+// A snapshot shaped like the child/child2 entries in the test app, many times over
+void BuildSnapshot(cereal::JsonObject& root)
+{
+    for (size_t i = 0; i < Records; ++i)
+    {
+        auto child = root.CreateObject();
+        child->Add("name", "John Doe " + std::to_string(i));
+        child->Add("age", static_cast<int>(i % 90));
+        child->Add("alive", i % 3 != 0);
+
+        auto coord = child->CreateObject();
+        coord->Add("x", 0.25 * static_cast<double>(i));
+        coord->Add("y", 2.0 + static_cast<double>(i % 100) / 7.0);
+        coord->Add("z", -1.5 * static_cast<double>(i % 13));
+        child->Add("3dcoord", coord);
+
+        root.Add("child" + std::to_string(i), child);
+    }
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunParallelBenchmarks()
+{
+    cereal::JsonObject snapshot;
+    BuildSnapshot(snapshot);
+
+    std::mt19937        rng(11);
+    std::vector<double> samples(Samples);
+    for (double& sample : samples)
+    {
+        sample = std::uniform_real_distribution<double>(-1e3, 1e3)(rng);
+    }
+    cereal::JsonObject series;
+    series.Add("samples", std::span<double>(samples));
+
+    // Powers of two up to the machine's thread count, and always at least 2 so the parallel path itself is measured
+    const unsigned maxThreads = (std::max)(2u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        cereal::ThreadPool pool(threads);
+
+        const std::string wide = "write 20k member snapshot, " + std::to_string(threads) + "t (docs)";
+        bench::Print(bench::Run(wide, 1, [&] {
+            const std::string json = snapshot.ToString(pool, true);
+            return json.size();
+        }));
+
+        const std::string longArray = "write 1M double array, " + std::to_string(threads) + "t (docs)";
+        bench::Print(bench::Run(longArray, 1, [&] {
+            const std::string json = series.ToString(pool);
+            return json.size();
+        }));
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,115 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Json.h"
+#include "cereal/Reader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Roughly the shape of our telemetry exports: a wide root of records, each holding a few scalars, a float series and
+// a nested object
+std::string MakeDocument(const size_t records)
+{
+    std::mt19937 rng(7);
+
+    std::vector<std::vector<float>> series(records);
+
+    cereal::JsonObject root;
+    for (size_t i = 0; i < records; ++i)
+    {
+        auto record = std::make_shared<cereal::JsonObject>();
+        record->Add("id", static_cast<int>(i));
+        record->Add("name", "record " + std::to_string(i));
+        record->Add("active", i % 3 == 0);
+        record->Add("value", std::uniform_real_distribution<double>(-1e6, 1e6)(rng));
+
+        series[i].resize(64);
+        for (float& f : series[i])
+        {
+            f = std::uniform_real_distribution<float>(-100.f, 100.f)(rng);
+        }
+        record->Add("series", std::span<float>(series[i]));
+
+        auto position = std::make_shared<cereal::JsonObject>();
+        position->Add("x", std::uniform_real_distribution<double>(-1, 1)(rng));
+        position->Add("y", std::uniform_real_distribution<double>(-1, 1)(rng));
+        position->Add("z", std::uniform_real_distribution<double>(-1, 1)(rng));
+        record->Add("position", position);
+
+        root.Add("record" + std::to_string(i), record);
+    }
+    return root.ToString(true);
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunParseBenchmarks()
+{
+    const std::string json = MakeDocument(5'000);
+
+    bench::Print(bench::Run("parse telemetry document (docs)", 1, [&] {
+        const cereal::JsonObject doc = cereal::JsonObject::Parse(json);
+        DoNotOptimize(doc);
+        return json.size();
+    }));
+
+    const std::string path = "bench_telemetry.json";
+    std::ofstream(path, std::ios::binary) << json;
+
+    bench::Print(bench::Run("read telemetry file (docs)", 1, [&] {
+        const cereal::JsonObject doc = cereal::JsonObject::ParseFile(path);
+        DoNotOptimize(doc);
+        return json.size();
+    }));
+
+    bench::Print(bench::Run("map telemetry file (docs)", 1, [&] {
+        const cereal::JsonObject doc = cereal::JsonObject::MapFile(path);
+        DoNotOptimize(doc);
+        return json.size();
+    }));
+
+    const cereal::JsonObject doc = cereal::JsonObject::Parse(json);
+    for (const auto io : { cereal::FileIo::Stream, cereal::FileIo::Direct })
+    {
+        const auto name = io == cereal::FileIo::Stream ? "print telemetry file, ofstream (docs)"
+                                                       : "print telemetry file, direct (docs)";
+        bench::Print(bench::Run(name, 1, [&] {
+            doc.PrintToFile(path, true, 4, io);
+            return json.size();
+        }));
+    }
+    std::remove(path.c_str());
+
+    bench::Print(bench::Run("stream telemetry document, 64 KiB window (docs)", 1, [&] {
+        cereal::StringSource source(json);
+        cereal::JsonReader   reader(source);
+        cereal::JsonHandler  handler;
+        reader.Parse(handler);
+        return json.size();
+    }));
+
+    bench::Print(bench::Run("stream telemetry document, skip series (docs)", 1, [&] {
+        cereal::StringSource source(json);
+        cereal::JsonReader   reader(source);
+        using Event = cereal::JsonReader::Event;
+        for (Event event = reader.Next(); event != Event::EndOfDocument; event = reader.Next())
+        {
+            if (event == Event::Key && reader.GetString() == "series")
+            {
+                reader.SkipValue();
+            }
+        }
+        return json.size();
+    }));
+}
+
+} // namespace bench
@@ -0,0 +1,95 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Cereal.h"
+
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Records = 100'000;
+
+// Same shape as Vector2/Vector3 in the test project, serialized both through a JsonObject and through the descriptor
+struct Vector2 : cereal::Serializable
+{
+    float x = 0.0f;
+    float y = 0.0f;
+
+    [[nodiscard]] std::shared_ptr<cereal::JsonObject> Serialize() override
+    {
+        cereal::JsonObject json;
+        json.Add("x", x);
+        json.Add("y", y);
+        return std::make_shared<cereal::JsonObject>(json);
+    }
+
+    CEREAL_DESCRIBE(Vector2, x, y)
+};
+
+struct Vector3 : cereal::Serializable
+{
+    double  x = 0.0;
+    double  y = 0.0;
+    double  z = 0.0;
+    Vector2 pos;
+
+    [[nodiscard]] std::shared_ptr<cereal::JsonObject> Serialize() override
+    {
+        cereal::JsonObject json;
+        json["x"]   = x;
+        json["y"]   = y;
+        json["z"]   = z;
+        json["pos"] = pos.Serialize();
+        return std::make_shared<cereal::JsonObject>(json);
+    }
+
+    CEREAL_DESCRIBE(Vector3, x, y, z, pos)
+};
+
+std::vector<Vector3> MakeRecords()
+{
+    std::vector<Vector3> records(Records);
+    for (size_t i = 0; i < Records; ++i)
+    {
+        records[i].x     = 0.25 * static_cast<double>(i);
+        records[i].y     = 0.5 * static_cast<double>(i);
+        records[i].z     = 1.5 * static_cast<double>(i);
+        records[i].pos.x = 0.75f * static_cast<float>(i);
+        records[i].pos.y = 1.25f;
+    }
+    return records;
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunReflectBenchmarks()
+{
+    std::vector<Vector3> records = MakeRecords();
+    std::string          out;
+
+    bench::Print(bench::Run("Vector3 via Serializable + JsonObject (records)", Records, [&] {
+        out.clear();
+        for (Vector3& record : records)
+        {
+            out += record.Serialize()->ToString();
+            out += '\n';
+        }
+        return out.size();
+    }));
+
+    bench::Print(bench::Run("Vector3 via CEREAL_DESCRIBE (records)", Records, [&] {
+        out.clear();
+        for (const Vector3& record : records)
+        {
+            cereal::Serializer<Vector3>::Write(out, record);
+            out += '\n';
+        }
+        return out.size();
+    }));
+}
+
+} // namespace bench
@@ -0,0 +1,122 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Json.h"
+#include "cereal/Pointer.h"
+#include "cereal/Snapshot.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Entities       = 2'000;
+constexpr size_t ChangedPerTick = 16;
+constexpr size_t History        = 64;
+
+// The same game state as the incremental benchmarks, kept as one version per tick
+cereal::JsonObject MakeState()
+{
+    cereal::JsonObject root;
+    auto               entities = root.CreateObject();
+    for (size_t i = 0; i < Entities; ++i)
+    {
+        auto entity = root.CreateObject();
+        entity->Add("id", static_cast<int>(i));
+        entity->Add("name", "entity_" + std::to_string(i));
+        entity->Add("health", 100.0);
+        entity->Add("alive", true);
+
+        auto pos = entity->CreateObject();
+        pos->Add("x", 0.5 * static_cast<double>(i));
+        pos->Add("y", 1.0);
+        pos->Add("z", -0.25 * static_cast<double>(i));
+        entity->Add("pos", pos);
+
+        entities->Add("e" + std::to_string(i), entity);
+    }
+    root.Add("tick", 0);
+    root.Add("entities", entities);
+    return root;
+}
+
+std::vector<cereal::JsonPointer> MakePaths()
+{
+    std::vector<cereal::JsonPointer> paths;
+    for (size_t i = 0; i < Entities; ++i)
+    {
+        paths.emplace_back("/entities/e" + std::to_string(i) + "/pos/x");
+    }
+    return paths;
+}
+
+size_t Moved(const size_t tick, const size_t i)
+{
+    return (tick * 131 + i * 977) % Entities;
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunSnapshotBenchmarks()
+{
+    {
+        // Every version is a full copy, which is what keeping history costs without structural sharing
+        cereal::JsonObject                root  = MakeState();
+        std::vector<cereal::JsonPointer>  paths = MakePaths();
+        std::vector<cereal::JsonSnapshot> history(History);
+        size_t                            tick = 0;
+        bench::Print(bench::Run("freeze whole state, 16 of 2000 moved (ticks)", 1, [&] {
+            ++tick;
+            for (size_t i = 0; i < ChangedPerTick; ++i)
+            {
+                paths[Moved(tick, i)].Set(root, static_cast<double>(tick) + 0.5);
+            }
+            root["tick"]            = static_cast<int>(tick);
+            history[tick % History] = cereal::JsonSnapshot(root);
+            return sizeof(cereal::JsonSnapshot);
+        }));
+    }
+
+    {
+        std::vector<cereal::JsonPointer>  paths = MakePaths();
+        std::vector<cereal::JsonSnapshot> history(History, cereal::JsonSnapshot(MakeState()));
+        const cereal::JsonPointer         tickPath("/tick");
+        size_t                            tick = 0;
+        bench::Print(bench::Run("path updates, 16 of 2000 moved (ticks)", 1, [&] {
+            cereal::JsonSnapshot version = history[tick % History];
+            ++tick;
+            for (size_t i = 0; i < ChangedPerTick; ++i)
+            {
+                version = version.Set(paths[Moved(tick, i)], static_cast<double>(tick) + 0.5);
+            }
+            history[tick % History] = version.Set(tickPath, static_cast<int>(tick));
+            return sizeof(cereal::JsonSnapshot);
+        }));
+    }
+
+    {
+        const cereal::JsonSnapshot       version(MakeState());
+        std::vector<cereal::JsonPointer> paths = MakePaths();
+        size_t                           i     = 0;
+        bench::Print(bench::Run("snapshot read by pointer (reads)", 1, [&] {
+            const double x = version.Get<double>(paths[i++ % Entities]);
+            DoNotOptimize(x);
+            return sizeof(double);
+        }));
+    }
+
+    {
+        const cereal::JsonSnapshot version(MakeState());
+        bench::Print(bench::Run("snapshot ToString (docs)", 1, [&] {
+            const std::string out = version.ToString();
+            return out.size();
+        }));
+    }
+}
+
+} // namespace bench
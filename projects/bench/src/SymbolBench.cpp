@@ -0,0 +1,84 @@
+#include "Bench.h"
+#include "Benchmarks.h"
+
+#include "cereal/Json.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t Records = 20'000;
+
+// The same records either way, keyed by plain strings or by interned symbols
+template<typename Key>
+std::vector<cereal::JsonObject> Build(const Key& x, const Key& y, const Key& z, const Key& pos)
+{
+    std::vector<cereal::JsonObject> records(Records);
+    for (size_t i = 0; i < Records; ++i)
+    {
+        cereal::JsonObject& record = records[i];
+        record.Add(x, 0.5 * static_cast<double>(i));
+        record.Add(y, static_cast<int>(i));
+        record.Add(z, -1.5);
+
+        auto position = std::make_shared<cereal::JsonObject>();
+        position->Add(x, 1.5f);
+        position->Add(y, 2.5f);
+        record.Add(pos, position);
+    }
+    return records;
+}
+
+template<typename Key>
+void RunFor(const char* keyName, const Key& x, const Key& y, const Key& z, const Key& pos)
+{
+    const std::string build = std::string("build 20k records, ") + keyName + " keys (records)";
+    bench::Print(bench::Run(build, Records, [&] {
+        const std::vector<cereal::JsonObject> records = Build(x, y, z, pos);
+        bench::DoNotOptimize(records);
+        return size_t{ 0 };
+    }));
+
+    const std::vector<cereal::JsonObject> records = Build(x, y, z, pos);
+
+    const std::string lookup = std::string("get 20k records, ") + keyName + " keys (lookups)";
+    bench::Print(bench::Run(lookup, Records * 4, [&] {
+        double sum = 0;
+        for (const cereal::JsonObject& record : records)
+        {
+            sum += record.Get<double>(x) + record.Get<int>(y) + record.Get<double>(z);
+            sum += record.GetObject(pos).template Get<float>(x);
+        }
+        bench::DoNotOptimize(sum);
+        return size_t{ 0 };
+    }));
+
+    std::string       out;
+    const std::string write = std::string("write 20k records, ") + keyName + " keys (records)";
+    bench::Print(bench::Run(write, Records, [&] {
+        out.clear();
+        cereal::JsonWriter writer(out);
+        for (const cereal::JsonObject& record : records)
+        {
+            record.Write(writer);
+        }
+        return out.size();
+    }));
+}
+
+} // namespace
+
+namespace bench
+{
+
+void RunSymbolBenchmarks()
+{
+    RunFor<std::string>("string", "x", "y", "z", "pos");
+    RunFor<cereal::Symbol>("interned", cereal::Intern("x"), cereal::Intern("y"), cereal::Intern("z"),
+                           cereal::Intern("pos"));
+}
+
+} // namespace bench
@@ -0,0 +1,78 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Arena.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Json.h"
+
+#include <memory>
+#include <memory_resource>
+
+namespace cereal
+{
+
+// Hands out memory for whole documents from a few large blocks. Keys, member storage, child objects made with
+// JsonObject::CreateObject and arrays read by Parse all come out of the arena, so building a document costs a handful of
+// mallocs and tearing it down never calls free. The blocks are returned together when the arena is destroyed or
+// Release is called, so every object made from it has to be gone by then.
+//
+// Not thread safe, use one arena per thread
+class JsonArena
+{
+public:
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    explicit JsonArena(const size_t initialBlockSize = DefaultBlockSize) : mResource(initialBlockSize) {}
+
+    JsonArena(const JsonArena&)            = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+
+    [[nodiscard]] std::pmr::memory_resource* GetResource() { return &mResource; }
+
+    [[nodiscard]] std::shared_ptr<JsonObject> MakeObject()
+    {
+        return std::allocate_shared<JsonObject>(std::pmr::polymorphic_allocator<JsonObject>(&mResource), &mResource);
+    }
+
+    [[nodiscard]] std::shared_ptr<JsonObject> Parse(const std::string_view json)
+    {
+        std::shared_ptr<JsonObject> root = MakeObject();
+        *root                            = JsonObject::Parse(json, &mResource);
+        return root;
+    }
+
+    [[nodiscard]] std::shared_ptr<JsonObject> ParseFile(const std::string_view filename)
+    {
+        std::shared_ptr<JsonObject> root = MakeObject();
+        *root                            = JsonObject::ParseFile(filename, &mResource);
+        return root;
+    }
+
+    // Gives every block back at once. Nothing made from this arena may be used afterwards
+    void Release() { mResource.release(); }
+
+private:
+    std::pmr::monotonic_buffer_resource mResource;
+};
+
+} // namespace cereal
@@ -0,0 +1,589 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Binary.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Reader.h"
+#include "Reflect.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace cereal
+{
+
+// The binary counterpart of Serializer. BinarySerializer<T>::Write appends the MessagePack or CBOR encoding of a value
+// to a BinaryWriter
+template<typename T>
+struct BinarySerializer;
+
+enum class BinaryFormat : uint8_t
+{
+    MessagePack,
+    Cbor
+};
+
+namespace detail
+{
+
+// Typed array tags from RFC 8746. Contiguous numbers are written as one of these followed by their raw bytes, CBOR
+// as a tagged byte string and MessagePack, which has no typed arrays of its own, as an ext with the same type number.
+// 0 means T can't be packed
+template<typename T>
+consteval uint8_t MakePackedTag(const bool littleEndian)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return littleEndian ? 85 : 81;
+    } else if constexpr (std::is_same_v<T, double>)
+    {
+        return littleEndian ? 86 : 82;
+    } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+    {
+        constexpr uint8_t base = std::is_signed_v<T> ? 72 : 64;
+        switch (sizeof(T))
+        {
+        case 1: return base;
+        case 2: return base + (littleEndian ? 5 : 1);
+        case 4: return base + (littleEndian ? 6 : 2);
+        case 8: return base + (littleEndian ? 7 : 3);
+        default: return 0;
+        }
+    } else
+    {
+        return 0;
+    }
+}
+
+// The tag for T in this machine's byte order, which is what the writer uses, and in the other one
+template<typename T>
+constexpr uint8_t PackedTag = MakePackedTag<T>(std::endian::native == std::endian::little);
+
+template<typename T>
+constexpr uint8_t SwappedPackedTag = MakePackedTag<T>(std::endian::native != std::endian::little);
+
+template<typename T>
+T ByteSwap(const T value)
+{
+    auto bytes = std::bit_cast<std::array<unsigned char, sizeof(T)>>(value);
+    std::reverse(bytes.begin(), bytes.end());
+    return std::bit_cast<T>(bytes);
+}
+
+} // namespace detail
+
+// Appends MessagePack or CBOR into a caller owned buffer. Containers are written with their element count up front, so
+// BeginArray(n) has to be followed by exactly n values and BeginMap(n) by n key/value pairs
+class BinaryWriter
+{
+public:
+    BinaryWriter(std::string& buffer, const BinaryFormat format) : mBuffer(buffer), mFormat(format) {}
+
+    [[nodiscard]] std::string& Buffer() { return mBuffer; }
+    [[nodiscard]] BinaryFormat Format() const { return mFormat; }
+
+    void WriteNull() { mBuffer += static_cast<char>(mFormat == BinaryFormat::Cbor ? 0xf6 : 0xc0); }
+
+    void WriteBool(const bool value)
+    {
+        if (mFormat == BinaryFormat::Cbor)
+        {
+            mBuffer += static_cast<char>(value ? 0xf5 : 0xf4);
+        } else
+        {
+            mBuffer += static_cast<char>(value ? 0xc3 : 0xc2);
+        }
+    }
+
+    void WriteUnsigned(const uint64_t value)
+    {
+        if (mFormat == BinaryFormat::Cbor)
+        {
+            WriteHeader(0, value);
+        } else if (value < 0x80)
+        {
+            mBuffer += static_cast<char>(value);
+        } else
+        {
+            WriteSized(value, 0xcc);
+        }
+    }
+
+    void WriteInteger(const int64_t value)
+    {
+        if (value >= 0)
+        {
+            WriteUnsigned(static_cast<uint64_t>(value));
+        } else if (mFormat == BinaryFormat::Cbor)
+        {
+            // Negative integers are stored as -1 - n
+            WriteHeader(1, ~static_cast<uint64_t>(value));
+        } else if (value >= -32)
+        {
+            mBuffer += static_cast<char>(value);
+        } else if (value >= INT8_MIN)
+        {
+            AppendBigEndian(static_cast<uint8_t>(0xd0), static_cast<int8_t>(value));
+        } else if (value >= INT16_MIN)
+        {
+            AppendBigEndian(static_cast<uint8_t>(0xd1), static_cast<int16_t>(value));
+        } else if (value >= INT32_MIN)
+        {
+            AppendBigEndian(static_cast<uint8_t>(0xd2), static_cast<int32_t>(value));
+        } else
+        {
+            AppendBigEndian(static_cast<uint8_t>(0xd3), value);
+        }
+    }
+
+    void WriteFloat(const float value)
+    {
+        AppendBigEndian(static_cast<uint8_t>(mFormat == BinaryFormat::Cbor ? 0xfa : 0xca), std::bit_cast<uint32_t>(value));
+    }
+
+    void WriteDouble(const double value)
+    {
+        AppendBigEndian(static_cast<uint8_t>(mFormat == BinaryFormat::Cbor ? 0xfb : 0xcb), std::bit_cast<uint64_t>(value));
+    }
+
+    void WriteString(const std::string_view text)
+    {
+        if (mFormat == BinaryFormat::Cbor)
+        {
+            WriteHeader(3, text.size());
+        } else if (text.size() < 32)
+        {
+            mBuffer += static_cast<char>(0xa0 | text.size());
+        } else
+        {
+            WriteLength(text.size(), 0xd9, 0xda, 0xdb);
+        }
+        mBuffer += text;
+    }
+
+    void BeginArray(const size_t count)
+    {
+        if (mFormat == BinaryFormat::Cbor)
+        {
+            WriteHeader(4, count);
+        } else if (count < 16)
+        {
+            mBuffer += static_cast<char>(0x90 | count);
+        } else
+        {
+            WriteLength(count, 0, 0xdc, 0xdd);
+        }
+    }
+
+    void BeginMap(const size_t count)
+    {
+        if (mFormat == BinaryFormat::Cbor)
+        {
+            WriteHeader(5, count);
+        } else if (count < 16)
+        {
+            mBuffer += static_cast<char>(0x80 | count);
+        } else
+        {
+            WriteLength(count, 0, 0xde, 0xdf);
+        }
+    }
+
+    // Writes count numbers as a single typed array. The elements are copied as they are in memory, and the tag records
+    // their byte order, so this is one append no matter how many there are
+    template<typename T>
+    void WritePacked(const T* values, const size_t count)
+    {
+        static_assert(detail::PackedTag<T> != 0, "Only numbers can be written as packed arrays");
+
+        const size_t size = count * sizeof(T);
+        if (mFormat == BinaryFormat::Cbor)
+        {
+            WriteHeader(6, detail::PackedTag<T>);
+            WriteHeader(2, size);
+        } else
+        {
+            WriteLength(size, 0xc7, 0xc8, 0xc9);
+            mBuffer += static_cast<char>(detail::PackedTag<T>);
+        }
+        mBuffer.append(reinterpret_cast<const char*>(values), size);
+    }
+
+    template<typename T>
+    void AppendValue(const T& value)
+    {
+        BinarySerializer<T>::Write(*this, value);
+    }
+
+private:
+    template<typename... Ts>
+    void AppendBigEndian(const Ts... values)
+    {
+        char  bytes[(sizeof(Ts) + ...)];
+        char* cursor = bytes;
+        (
+            [&cursor](auto value) {
+                for (size_t i = sizeof(value); i-- > 0;)
+                {
+                    *cursor++ = static_cast<char>(static_cast<uint64_t>(value) >> (i * 8));
+                }
+            }(values),
+            ...);
+        mBuffer.append(bytes, sizeof(bytes));
+    }
+
+    // A CBOR major type and its argument, in the fewest bytes that hold it
+    void WriteHeader(const uint8_t major, const uint64_t value)
+    {
+        const auto type = static_cast<uint8_t>(major << 5);
+        if (value < 24)
+        {
+            mBuffer += static_cast<char>(type | value);
+        } else
+        {
+            WriteSized(value, type | 24);
+        }
+    }
+
+    // One of four consecutive markers for an 8, 16, 32 or 64 bit value, followed by the value. MessagePack's uints and
+    // CBOR's arguments both work this way
+    void WriteSized(const uint64_t value, const uint8_t marker)
+    {
+        if (value <= UINT8_MAX)
+        {
+            AppendBigEndian(marker, static_cast<uint8_t>(value));
+        } else if (value <= UINT16_MAX)
+        {
+            AppendBigEndian(static_cast<uint8_t>(marker + 1), static_cast<uint16_t>(value));
+        } else if (value <= UINT32_MAX)
+        {
+            AppendBigEndian(static_cast<uint8_t>(marker + 2), static_cast<uint32_t>(value));
+        } else
+        {
+            AppendBigEndian(static_cast<uint8_t>(marker + 3), value);
+        }
+    }
+
+    // MessagePack lengths. marker8 is 0 for containers, which have no 8 bit form
+    void WriteLength(const size_t length, const uint8_t marker8, const uint8_t marker16, const uint8_t marker32)
+    {
+        if (marker8 && length <= UINT8_MAX)
+        {
+            AppendBigEndian(marker8, static_cast<uint8_t>(length));
+        } else if (length <= UINT16_MAX)
+        {
+            AppendBigEndian(marker16, static_cast<uint16_t>(length));
+        } else if (length <= UINT32_MAX)
+        {
+            AppendBigEndian(marker32, static_cast<uint32_t>(length));
+        } else
+        {
+            throw std::runtime_error("Value is too large to write as MessagePack");
+        }
+    }
+
+private:
+    std::string& mBuffer;
+    BinaryFormat mFormat;
+};
+
+// Reads MessagePack or CBOR from memory and reports it as the same events JsonReader does, so anything written against
+// JsonReader's events can read binary too. Strings and keys returned by GetString() point straight into the input.
+//
+// Packed arrays are reported as StartArray, one Integer or Double event per element and EndArray. Right after their
+// StartArray, TakePacked can copy all of the elements in one go instead
+class BinaryReader
+{
+public:
+    using Event = JsonReader::Event;
+
+    static constexpr size_t MaxDepth = 1024;
+
+    BinaryReader(std::string_view bytes, BinaryFormat format);
+
+    Event Next();
+
+    // Skips the value following the last Key event, or the rest of the object/array started by the last event
+    void SkipValue();
+
+    // Copies the rest of the packed array that was just started into values and moves past its end, if the elements
+    // are stored as exactly T. Returns false, and consumes nothing, for anything else
+    template<typename T>
+    bool TakePacked(std::vector<T>& values)
+    {
+        if constexpr (detail::PackedTag<T> == 0)
+        {
+            return false;
+        } else
+        {
+            const char* data    = nullptr;
+            size_t      count   = 0;
+            bool        swapped = false;
+            if (!TakePackedBytes(detail::PackedTag<T>, detail::SwappedPackedTag<T>, sizeof(T), data, count, swapped))
+            {
+                return false;
+            }
+
+            values.resize(count);
+            if (count > 0)
+            {
+                std::memcpy(values.data(), data, count * sizeof(T));
+            }
+            if (swapped)
+            {
+                for (T& value : values)
+                {
+                    value = detail::ByteSwap(value);
+                }
+            }
+            return true;
+        }
+    }
+
+    [[nodiscard]] std::string_view GetString() const { return mString; }
+    [[nodiscard]] int64_t          GetInteger() const { return mInteger; }
+    [[nodiscard]] double           GetDouble() const { return mDouble; }
+    [[nodiscard]] bool             GetBool() const { return mBool; }
+
+    [[nodiscard]] BinaryFormat Format() const { return mFormat; }
+    [[nodiscard]] size_t       Depth() const { return mStack.size(); }
+    [[nodiscard]] size_t       Offset() const { return mPos; }
+
+    // Throws std::runtime_error naming the format and the current offset
+    [[noreturn]] void Error(std::string_view message) const;
+
+private:
+    enum class Kind : uint8_t
+    {
+        Array,
+        Map,
+        Packed
+    };
+
+    struct Frame
+    {
+        uint64_t remaining  = 0; // Elements, or key/value pairs, still to come. Unused when indefinite
+        Kind     kind       = Kind::Array;
+        bool     indefinite = false; // CBOR containers that end with a break byte instead of a count
+        bool     value      = false; // For maps, whether the next item is a value rather than a key
+        uint8_t  tag        = 0;     // For packed arrays, the typed array tag
+    };
+
+    bool TakePackedBytes(uint8_t tag, uint8_t swappedTag, size_t size, const char*& data, size_t& count, bool& swapped);
+
+    Event ReadValue();
+    Event ReadMessagePack();
+    Event ReadCbor();
+    Event ReadPackedElement(const Frame& frame);
+
+    Event Start(Kind kind, uint64_t count, bool indefinite = false);
+    Event StartPacked(uint8_t tag, uint64_t size);
+    Event String(uint64_t length);
+    Event Unsigned(uint64_t value);
+    Event Signed(int64_t value);
+    Event Float(double value);
+
+    uint8_t  Byte();
+    uint64_t BigEndian(size_t size);
+    void     Need(uint64_t size) const;
+
+private:
+    std::string_view   mBytes;
+    BinaryFormat       mFormat;
+    size_t             mPos = 0;
+    std::vector<Frame> mStack;
+    bool               mDone = false; // The root value has been read
+    Event              mLast = Event::EndOfDocument;
+
+    std::string_view mString;
+    int64_t          mInteger = 0;
+    double           mDouble  = 0.0;
+    bool             mBool    = false;
+};
+
+#pragma region Binary Serializers
+
+// Writes a range as a packed array when its elements are contiguous numbers, otherwise element by element
+template<typename It>
+void WriteBinaryRange(BinaryWriter& out, It first, It last)
+{
+    using T = std::decay_t<decltype(*first)>;
+
+    const auto count = static_cast<size_t>(std::distance(first, last));
+    if constexpr (std::contiguous_iterator<It> && detail::PackedTag<T> != 0)
+    {
+        if (count > 0)
+        {
+            out.WritePacked(std::to_address(first), count);
+            return;
+        }
+    }
+
+    out.BeginArray(count);
+    for (It it = first; it != last; ++it)
+    {
+        BinarySerializer<T>::Write(out, *it);
+    }
+}
+
+template<typename T>
+struct BinarySerializer
+{
+    static void Write(BinaryWriter& out, const T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            out.WriteBool(value);
+        } else if constexpr (std::is_same_v<T, char>)
+        {
+            // Written as a one character string, the same as json does
+            out.WriteString(std::string_view(&value, 1));
+        } else if constexpr (std::is_same_v<T, float>)
+        {
+            out.WriteFloat(value);
+        } else if constexpr (std::is_floating_point_v<T>)
+        {
+            out.WriteDouble(static_cast<double>(value));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        {
+            out.WriteInteger(value);
+        } else if constexpr (std::is_integral_v<T>)
+        {
+            out.WriteUnsigned(value);
+        } else if constexpr (std::is_same_v<T, std::nullptr_t>)
+        {
+            out.WriteNull();
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+            out.WriteString(value);
+        } else
+        {
+            static_assert(sizeof(T) == 0, "No BinarySerializer for this type");
+        }
+    }
+};
+
+template<typename T>
+struct BinarySerializer<std::vector<T>>
+{
+    static void Write(BinaryWriter& out, const std::vector<T>& value) { WriteBinaryRange(out, value.begin(), value.end()); }
+};
+
+template<typename T, size_t N>
+struct BinarySerializer<std::array<T, N>>
+{
+    static void Write(BinaryWriter& out, const std::array<T, N>& value) { WriteBinaryRange(out, value.begin(), value.end()); }
+};
+
+template<typename T>
+struct BinarySerializer<std::span<T>>
+{
+    static void Write(BinaryWriter& out, const std::span<T> value) { WriteBinaryRange(out, value.begin(), value.end()); }
+};
+
+template<typename T>
+struct BinarySerializer<std::unordered_map<std::string, T>>
+{
+    static void Write(BinaryWriter& out, const std::unordered_map<std::string, T>& value)
+    {
+        out.BeginMap(value.size());
+        for (const auto& [key, item] : value)
+        {
+            out.WriteString(key);
+            BinarySerializer<T>::Write(out, item);
+        }
+    }
+};
+
+template<typename T>
+struct BinarySerializer<std::shared_ptr<T>>
+{
+    static void Write(BinaryWriter& out, const std::shared_ptr<T>& value)
+    {
+        if (!value)
+        {
+            out.WriteNull();
+            return;
+        }
+        BinarySerializer<std::remove_const_t<T>>::Write(out, *value);
+    }
+};
+
+template<typename... Ts>
+struct BinarySerializer<std::variant<Ts...>>
+{
+    static void Write(BinaryWriter& out, const std::variant<Ts...>& value)
+    {
+        std::visit([&out]<typename T>(const T& item) { BinarySerializer<T>::Write(out, item); }, value);
+    }
+};
+
+template<Described T>
+struct BinarySerializer<T>
+{
+    static void Write(BinaryWriter& out, const T& value)
+    {
+        static constexpr auto fields = T::CerealFields();
+
+        out.BeginMap(std::tuple_size_v<decltype(fields)>);
+        std::apply(
+            [&](const auto&... field) {
+                ((out.WriteString(field.Name()),
+                  BinarySerializer<typename std::decay_t<decltype(field)>::MemberType>::Write(out, value.*field.member)),
+                 ...);
+            },
+            fields);
+    }
+};
+
+#pragma endregion Binary Serializers
+
+template<typename T>
+void WriteBinary(std::string& out, const T& value, const BinaryFormat format)
+{
+    BinaryWriter writer(out, format);
+    BinarySerializer<T>::Write(writer, value);
+}
+
+template<typename T>
+[[nodiscard]] std::string SerializeBinary(const T& value, const BinaryFormat format)
+{
+    std::string out;
+    WriteBinary(out, value, format);
+    return out;
+}
+
+} // namespace cereal
@@ -0,0 +1,115 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Builder.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Json.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cereal
+{
+
+// Builds one object from several threads at once. Members are spread over shards by the hash of their key, each shard
+// behind a lock of its own, so threads adding different keys rarely wait on each other. Values are made before the
+// lock is taken and the lock is only held to put them in place.
+//
+// Members are written and frozen sorted by their utf-8 bytes, whichever thread added them and in whatever order, so
+// the same members always make the same document. Adding a key that is already there replaces its value. Add and
+// Object can be called from any number of threads, Size, Freeze, Write and ToString only once every producer is done
+class JsonBuilder
+{
+public:
+    static constexpr size_t DefaultShards = 16;
+
+    // shards is rounded up to a power of two
+    explicit JsonBuilder(size_t shards = DefaultShards);
+
+    JsonBuilder(const JsonBuilder&)            = delete;
+    JsonBuilder& operator=(const JsonBuilder&) = delete;
+
+    template<typename T>
+        requires detail::Storable<T> || std::is_same_v<std::decay_t<T>, JsonValue>
+    void Add(const std::string_view key, T&& value)
+    {
+        Store(key, JsonValue(std::forward<T>(value)));
+    }
+
+    // The nested builder under key, added on first use. Threads asking for the same key get the same builder, which
+    // lives as long as this one. A nested builder has a single shard unless asked for more, as it is usually filled by
+    // one thread. Throws std::runtime_error if key holds a value
+    [[nodiscard]] JsonBuilder& Object(std::string_view key, size_t shards = 1);
+
+    [[nodiscard]] size_t Size() const;
+
+    // Moves every member into a JsonObject, nested builders into nested objects, and leaves the builder empty
+    [[nodiscard]] JsonObject Freeze();
+
+    // Writes the members straight from the shards, the same as the frozen object would write them
+    [[nodiscard]] std::string ToString(bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
+
+    void Write(JsonWriter& writer, bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
+
+private:
+    // A value, or a nested builder when object is set
+    struct Member
+    {
+        JsonValue                    value;
+        std::unique_ptr<JsonBuilder> object;
+    };
+
+    using MemberMap = std::unordered_map<std::string, Member, StringHash, StringEqual>;
+
+    // A cache line each so threads locking neighbouring shards don't slow each other down
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        MemberMap  members;
+    };
+
+    [[nodiscard]] Shard& ShardOf(std::string_view key) const;
+
+    void Store(std::string_view key, JsonValue&& value);
+
+    // Every member of every shard, sorted by key
+    [[nodiscard]] std::vector<MemberMap::value_type*> Sorted() const;
+
+    void FreezeInto(JsonObject& object);
+
+    template<typename Output>
+    void WriteObject(JsonWriter& writer, int indentLevel, int indentSize) const;
+
+private:
+    std::unique_ptr<Shard[]> mShards;
+    size_t                   mMask = 0;
+};
+
+} // namespace cereal
@@ -1,4 +1,4 @@
-// ------------------------------------------------------------------------------
+﻿// ------------------------------------------------------------------------------
 //
 // Cereal
 //    Copyright 2025 Matthew Rogers
@@ -25,6 +25,18 @@
 
 #include "Serializer.h"
 #include "Json.h"
+#include "Arena.h"
+#include "Reader.h"
+#include "Reflect.h"
+#include "Binary.h"
+#include "Deserializer.h"
+#include "ThreadPool.h"
+#include "Ndjson.h"
+#include "Pointer.h"
+#include "Lazy.h"
+#include "Snapshot.h"
+#include "Builder.h"
+#include "Instrument.h"
 
 namespace cereal
 {
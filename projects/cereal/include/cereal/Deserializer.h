@@ -0,0 +1,406 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Deserializer.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Binary.h"
+#include "Reader.h"
+#include "Reflect.h"
+#include "Value.h"
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cereal
+{
+
+// The reading counterpart of Serializer. Deserializer<T>::Read fills a T straight from a JsonReader, or a BinaryReader
+// which reports the same events, with no JsonObject in between. It is called once the reader has returned the first
+// event of the value, and leaves the reader on the value's last event
+template<typename T>
+struct Deserializer;
+
+// Where a value sits in the document, for error messages. It lives on the stack as the readers descend, so nothing is
+// allocated unless something goes wrong
+struct ReadPath
+{
+    const ReadPath*  parent = nullptr;
+    std::string_view key;
+    size_t           index = SIZE_MAX; // Set instead of key for array elements
+
+    [[nodiscard]] std::string ToString() const
+    {
+        std::string path = parent ? parent->ToString() : std::string();
+        if (index != SIZE_MAX)
+        {
+            path += '[' + std::to_string(index) + ']';
+        } else if (!key.empty())
+        {
+            if (!path.empty())
+            {
+                path += '.';
+            }
+            path += key;
+        }
+        return path;
+    }
+};
+
+namespace detail
+{
+
+inline std::string_view EventName(const JsonReader::Event event)
+{
+    switch (event)
+    {
+    case JsonReader::Event::StartObject: return "object";
+    case JsonReader::Event::StartArray: return "array";
+    case JsonReader::Event::String: return "string";
+    case JsonReader::Event::Integer: return "integer";
+    case JsonReader::Event::Double: return "double";
+    case JsonReader::Event::Bool: return "bool";
+    case JsonReader::Event::Null: return "null";
+    default: return "end of input";
+    }
+}
+
+template<typename Reader>
+std::string DescribeLocation(const Reader& reader, const ReadPath& path)
+{
+    const std::string key = path.ToString();
+    return (key.empty() ? std::string() : " for key: " + key) + " (offset " + std::to_string(reader.Offset()) + ")";
+}
+
+template<typename T, typename Reader>
+[[noreturn]] void ThrowReadMismatch(const Reader& reader, const JsonReader::Event found, const ReadPath& path)
+{
+    throw std::runtime_error("Type mismatch: Expected '" + GetTypeName<T>() + "', but found '" +
+                             std::string(EventName(found)) + "'" + DescribeLocation(reader, path));
+}
+
+// Reads the elements of an array whose StartArray was just returned, calling read(event, path) for each one
+template<typename Reader, typename Fn>
+void ReadElements(Reader& reader, const ReadPath& path, Fn&& read)
+{
+    size_t index = 0;
+    for (JsonReader::Event event = reader.Next(); event != JsonReader::Event::EndArray; event = reader.Next())
+    {
+        read(event, ReadPath{ &path, {}, index++ });
+    }
+}
+
+} // namespace detail
+
+template<typename T>
+    requires std::is_arithmetic_v<T>
+struct Deserializer<T>
+{
+    template<typename Reader>
+    static void Read(Reader& reader, const JsonReader::Event event, T& value, const ReadPath& path)
+    {
+        using Event = JsonReader::Event;
+
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            if (event != Event::Bool)
+            {
+                detail::ThrowReadMismatch<T>(reader, event, path);
+            }
+            value = reader.GetBool();
+        } else if constexpr (std::is_same_v<T, char>)
+        {
+            // Written as a one character string
+            if (event != Event::String || reader.GetString().size() != 1)
+            {
+                detail::ThrowReadMismatch<T>(reader, event, path);
+            }
+            value = reader.GetString()[0];
+        } else if constexpr (std::is_floating_point_v<T>)
+        {
+            if (event == Event::Double)
+            {
+                value = static_cast<T>(reader.GetDouble());
+            } else if (event == Event::Integer)
+            {
+                value = static_cast<T>(reader.GetInteger());
+            } else
+            {
+                detail::ThrowReadMismatch<T>(reader, event, path);
+            }
+        } else
+        {
+            if (event != Event::Integer)
+            {
+                detail::ThrowReadMismatch<T>(reader, event, path);
+            }
+            if (!std::in_range<T>(reader.GetInteger()))
+            {
+                throw std::runtime_error("Value out of range: " + std::to_string(reader.GetInteger()) + " does not fit in '" +
+                                         GetTypeName<T>() + "'" + detail::DescribeLocation(reader, path));
+            }
+            value = static_cast<T>(reader.GetInteger());
+        }
+    }
+};
+
+template<>
+struct Deserializer<std::string>
+{
+    template<typename Reader>
+    static void Read(Reader& reader, const JsonReader::Event event, std::string& value, const ReadPath& path)
+    {
+        if (event != JsonReader::Event::String)
+        {
+            detail::ThrowReadMismatch<std::string>(reader, event, path);
+        }
+        value.assign(reader.GetString());
+    }
+};
+
+template<typename T>
+struct Deserializer<std::vector<T>>
+{
+    template<typename Reader>
+    static void Read(Reader& reader, const JsonReader::Event event, std::vector<T>& value, const ReadPath& path)
+    {
+        if (event != JsonReader::Event::StartArray)
+        {
+            detail::ThrowReadMismatch<std::vector<T>>(reader, event, path);
+        }
+
+        // Binary packed arrays of exactly T are copied in one go
+        if constexpr (requires { reader.TakePacked(value); })
+        {
+            if (reader.TakePacked(value))
+            {
+                return;
+            }
+        }
+
+        value.clear();
+        detail::ReadElements(reader, path, [&](const JsonReader::Event element, const ReadPath& elementPath) {
+            T item{};
+            Deserializer<T>::Read(reader, element, item, elementPath);
+            value.push_back(std::move(item));
+        });
+    }
+};
+
+template<typename T, size_t N>
+struct Deserializer<std::array<T, N>>
+{
+    template<typename Reader>
+    static void Read(Reader& reader, const JsonReader::Event event, std::array<T, N>& value, const ReadPath& path)
+    {
+        if (event != JsonReader::Event::StartArray)
+        {
+            detail::ThrowReadMismatch<std::array<T, N>>(reader, event, path);
+        }
+
+        size_t count = 0;
+        detail::ReadElements(reader, path, [&](const JsonReader::Event element, const ReadPath& elementPath) {
+            if (count == N)
+            {
+                throw std::runtime_error("Too many elements: Expected " + std::to_string(N) +
+                                         detail::DescribeLocation(reader, path));
+            }
+            Deserializer<T>::Read(reader, element, value[count++], elementPath);
+        });
+
+        if (count != N)
+        {
+            throw std::runtime_error("Too few elements: Expected " + std::to_string(N) + ", but found " +
+                                     std::to_string(count) + detail::DescribeLocation(reader, path));
+        }
+    }
+};
+
+template<typename T>
+struct Deserializer<std::unordered_map<std::string, T>>
+{
+    using Map = std::unordered_map<std::string, T>;
+
+    template<typename Reader>
+    static void Read(Reader& reader, const JsonReader::Event event, Map& value, const ReadPath& path)
+    {
+        if (event != JsonReader::Event::StartObject)
+        {
+            detail::ThrowReadMismatch<Map>(reader, event, path);
+        }
+
+        value.clear();
+        for (JsonReader::Event key = reader.Next(); key != JsonReader::Event::EndObject; key = reader.Next())
+        {
+            // The key only lives until the next event, so it has to be copied before reading the value
+            const auto it = value.try_emplace(std::string(reader.GetString())).first;
+            Deserializer<T>::Read(reader, reader.Next(), it->second, ReadPath{ &path, it->first });
+        }
+    }
+};
+
+// Described types are read key by key. The fields are tried in the order they were described first, which is the
+// order they are written in, so documents this library wrote match on the first comparison. Keys the type doesn't
+// describe are skipped without being decoded, and every described key has to be present
+template<Described T>
+struct Deserializer<T>
+{
+    static constexpr auto   Fields = T::CerealFields();
+    static constexpr size_t Count  = std::tuple_size_v<decltype(Fields)>;
+
+    static constexpr std::array<std::string_view, Count> Names =
+        std::apply([](const auto&... field) { return std::array<std::string_view, Count>{ field.Name()... }; }, Fields);
+
+    template<typename Reader>
+    static void Read(Reader& reader, const JsonReader::Event event, T& value, const ReadPath& path)
+    {
+        if (event != JsonReader::Event::StartObject)
+        {
+            detail::ThrowReadMismatch<T>(reader, event, path);
+        }
+
+        uint64_t seen = 0;
+        size_t   next = 0;
+        for (JsonReader::Event key = reader.Next(); key != JsonReader::Event::EndObject; key = reader.Next())
+        {
+            const size_t index = Find(reader.GetString(), next);
+            if (index == Count)
+            {
+                reader.SkipValue();
+                continue;
+            }
+
+            ReadField(reader, value, index, ReadPath{ &path, Names[index] }, std::make_index_sequence<Count>{});
+            seen |= uint64_t{ 1 } << index;
+            next = index + 1;
+        }
+
+        for (size_t i = 0; i < Count; ++i)
+        {
+            if (!(seen & (uint64_t{ 1 } << i)))
+            {
+                throw std::runtime_error("Key not found in json: " + ReadPath{ &path, Names[i] }.ToString());
+            }
+        }
+    }
+
+private:
+    [[nodiscard]] static size_t Find(const std::string_view key, const size_t expected)
+    {
+        if (expected < Count && Names[expected] == key)
+        {
+            return expected;
+        }
+        for (size_t i = 0; i < Count; ++i)
+        {
+            if (Names[i] == key)
+            {
+                return i;
+            }
+        }
+        return Count;
+    }
+
+    template<typename Reader, size_t... I>
+    static void ReadField(Reader& reader, T& value, const size_t index, const ReadPath& path, std::index_sequence<I...>)
+    {
+        const JsonReader::Event event = reader.Next();
+        static_cast<void>(((index == I ? (ReadMember<I>(reader, event, value, path), true) : false) || ...));
+    }
+
+    template<size_t I, typename Reader>
+    static void ReadMember(Reader& reader, const JsonReader::Event event, T& value, const ReadPath& path)
+    {
+        constexpr auto field = std::get<I>(Fields);
+        Deserializer<typename decltype(field)::MemberType>::Read(reader, event, value.*field.member, path);
+    }
+};
+
+// Reads the next value from reader into value
+template<typename T>
+void Deserialize(JsonReader& reader, T& value)
+{
+    Deserializer<T>::Read(reader, reader.Next(), value, ReadPath{});
+}
+
+// Reads a whole document into value. Throws std::runtime_error if the document is malformed, is missing a described
+// key, holds a value of the wrong type or has anything after the value
+template<typename T>
+void Deserialize(JsonSource& source, T& value)
+{
+    JsonReader reader(source);
+    Deserialize(reader, value);
+    if (reader.Next() != JsonReader::Event::EndOfDocument)
+    {
+        throw std::runtime_error("Unexpected data after the value at offset " + std::to_string(reader.Offset()));
+    }
+}
+
+template<typename T>
+void Deserialize(const std::string_view json, T& value)
+{
+    StringSource source(json);
+    Deserialize(source, value);
+}
+
+template<typename T>
+void Deserialize(std::istream& stream, T& value)
+{
+    StreamSource source(stream);
+    Deserialize(source, value);
+}
+
+// Reads a whole MessagePack or CBOR document into value, with the same checks as reading json
+template<typename T>
+void DeserializeBinary(const std::string_view bytes, const BinaryFormat format, T& value)
+{
+    BinaryReader reader(bytes, format);
+    Deserializer<T>::Read(reader, reader.Next(), value, ReadPath{});
+    reader.Next(); // Throws if anything follows the value
+}
+
+template<typename T>
+[[nodiscard]] T Deserialize(const std::string_view json)
+{
+    T value{};
+    Deserialize(json, value);
+    return value;
+}
+
+template<typename T>
+[[nodiscard]] T DeserializeBinary(const std::string_view bytes, const BinaryFormat format)
+{
+    T value{};
+    DeserializeBinary(bytes, format, value);
+    return value;
+}
+
+} // namespace cereal
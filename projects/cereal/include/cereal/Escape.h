@@ -0,0 +1,43 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Escape.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace cereal
+{
+
+// Appends text to out as a quoted json string, escaping quotes, backslashes and control characters as required by
+// RFC 8259. Runs of characters that need no escaping are found 16 or 32 bytes at a time and copied in one go
+void WriteEscapedString(std::string& out, std::string_view text);
+
+// Same as WriteEscapedString, minus the surrounding quotes
+void WriteEscaped(std::string& out, std::string_view text);
+
+// The reverse of WriteEscaped. Appends the decoded contents of a json string (without its quotes) to out, turning
+// \uXXXX escapes, surrogate pairs included, into utf-8. Throws std::runtime_error on a malformed escape
+void WriteUnescaped(std::string& out, std::string_view text);
+
+} // namespace cereal
@@ -0,0 +1,244 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Instrument.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Set to 1 to count and time every ToString, PrintToFile, Serialize and parse call. Off by default, in which case none
+// of it is compiled in and the functions below report nothing. Like the precision knobs, it has to be defined the same
+// way for the library and for everything that includes its headers
+#ifndef CEREAL_INSTRUMENT
+    #define CEREAL_INSTRUMENT 0
+#endif
+
+namespace cereal
+{
+
+inline constexpr bool InstrumentEnabled = CEREAL_INSTRUMENT != 0;
+
+enum class Operation : uint8_t
+{
+    ToString,
+    PrintToFile,
+    Serialize,
+    Parse,
+    ParseFile,
+    MapFile,
+    Count
+};
+
+// Where an operation spends its time. Phases nest, and the time of each only counts what isn't inside a phase nested
+// in it, so the phases of an operation add up to its total
+enum class Phase : uint8_t
+{
+    Read,   // Reading or mapping the input file
+    Index,  // Finding the structural characters of the input
+    Build,  // Building the JsonObject tree from them
+    Walk,   // Going through the tree: dispatching on types, writing keys, punctuation and indentation
+    Values, // Formatting numbers, strings and arrays. Timed one value at a time, which adds to the time it reports
+    Io,     // Opening the output file and handing it what was written
+    Count
+};
+
+[[nodiscard]] std::string_view OperationName(Operation operation);
+[[nodiscard]] std::string_view PhaseName(Phase phase);
+
+struct OperationStats
+{
+    uint64_t calls          = 0;
+    uint64_t allocations    = 0; // Made by cereal itself: values, keys, member storage, arrays and JsonWriter buffers
+    uint64_t allocatedBytes = 0;
+    uint64_t bytes          = 0; // Written, or read when parsing
+    uint64_t nodes          = 0; // Values visited, array elements included
+    double   seconds        = 0.0;
+
+    std::array<double, static_cast<size_t>(Phase::Count)> phaseSeconds{};
+
+    [[nodiscard]] double PhaseSeconds(const Phase phase) const { return phaseSeconds[static_cast<size_t>(phase)]; }
+};
+
+// Totals since the program started or since the last ResetInstrumentStats, per kind of operation. Calls nested in
+// another operation, such as the Parse inside ParseFile, count towards the outer one
+struct InstrumentStats
+{
+    std::array<OperationStats, static_cast<size_t>(Operation::Count)> operations{};
+
+    [[nodiscard]] const OperationStats& operator[](const Operation operation) const
+    {
+        return operations[static_cast<size_t>(operation)];
+    }
+
+    // One line per operation that was called, with the time of each phase
+    [[nodiscard]] std::string ToString() const;
+};
+
+[[nodiscard]] InstrumentStats GetInstrumentStats();
+void                          ResetInstrumentStats();
+
+// While tracing, every operation and phase (other than Values) is also recorded as an event with its start, duration
+// and thread. WriteTrace writes them in the Chrome trace event format, for chrome://tracing or ui.perfetto.dev.
+// Starting a trace drops the events of the previous one
+void StartTrace();
+void StopTrace();
+void WriteTrace(std::string_view filename);
+
+#if CEREAL_INSTRUMENT
+
+namespace detail
+{
+
+struct InstrumentContext
+{
+    Operation             operation;
+    std::atomic<uint64_t> allocations    = 0;
+    std::atomic<uint64_t> allocatedBytes = 0;
+    std::atomic<uint64_t> bytes          = 0;
+    std::atomic<uint64_t> nodes          = 0;
+
+    // Only ever touched by the thread running the operation
+    std::array<int64_t, static_cast<size_t>(Phase::Count)> phaseNanoseconds{};
+    Phase                                                  phase;
+    int64_t                                                start      = 0;
+    int64_t                                                phaseStart = 0;
+};
+
+// Times everything up to the end of the scope as one operation. Does nothing when another operation is already running
+// on this thread, which then gets the time and counts instead
+class OperationScope
+{
+public:
+    OperationScope(Operation operation, Phase phase);
+    ~OperationScope();
+
+    // The size of what the operation produced or read, unless it is nested in another operation that counts its own
+    void Result(const size_t bytes)
+    {
+        if (mOuter)
+        {
+            mContext.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    OperationScope(const OperationScope&)            = delete;
+    OperationScope& operator=(const OperationScope&) = delete;
+
+private:
+    InstrumentContext  mContext;
+    InstrumentContext* mPrevious;
+    bool               mOuter;
+};
+
+class PhaseScope
+{
+public:
+    explicit PhaseScope(Phase phase);
+    ~PhaseScope();
+
+    PhaseScope(const PhaseScope&)            = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    InstrumentContext* mContext;
+    Phase              mPhase;
+    Phase              mPrevious;
+    int64_t            mStart;
+};
+
+// The operation running on this thread, or that this thread is helping with
+[[nodiscard]] InstrumentContext* CurrentInstrumentContext();
+
+// Lets a pool thread count towards the operation of the thread that gave it work. Its time isn't phased, the operation's
+// own thread is already timing the wait for it
+class AttachScope
+{
+public:
+    explicit AttachScope(InstrumentContext* context);
+    ~AttachScope();
+
+    AttachScope(const AttachScope&)            = delete;
+    AttachScope& operator=(const AttachScope&) = delete;
+
+private:
+    InstrumentContext* mPrevious;
+};
+
+void CountAllocation(size_t bytes);
+void CountBytes(size_t bytes);
+void CountNodes(size_t nodes);
+
+// Counts a string or vector growing while the scope is open
+template<typename Buffer>
+class GrowthScope
+{
+public:
+    explicit GrowthScope(const Buffer& buffer) : mBuffer(buffer), mCapacity(buffer.capacity()) {}
+
+    ~GrowthScope()
+    {
+        if (mBuffer.capacity() != mCapacity)
+        {
+            CountAllocation(mBuffer.capacity() * sizeof(typename Buffer::value_type));
+        }
+    }
+
+    GrowthScope(const GrowthScope&)            = delete;
+    GrowthScope& operator=(const GrowthScope&) = delete;
+
+private:
+    const Buffer& mBuffer;
+    size_t        mCapacity;
+};
+
+} // namespace detail
+
+#endif
+
+} // namespace cereal
+
+// Everything cereal records goes through these, so none of it is left behind when instrumentation is off
+#if CEREAL_INSTRUMENT
+    #define CEREAL_INSTRUMENT_OPERATION(operation, phase) ::cereal::detail::OperationScope cerealOperation(operation, phase)
+    #define CEREAL_INSTRUMENT_RESULT(bytes)               cerealOperation.Result(bytes)
+    #define CEREAL_INSTRUMENT_PHASE(phase)                const ::cereal::detail::PhaseScope cerealPhase(phase)
+    #define CEREAL_INSTRUMENT_CAPTURE(context)            ::cereal::detail::InstrumentContext* context = ::cereal::detail::CurrentInstrumentContext()
+    #define CEREAL_INSTRUMENT_ATTACH(context)             const ::cereal::detail::AttachScope cerealAttach(context)
+    #define CEREAL_INSTRUMENT_ALLOCATION(bytes)           ::cereal::detail::CountAllocation(bytes)
+    #define CEREAL_INSTRUMENT_GROWTH(buffer)              const ::cereal::detail::GrowthScope cerealGrowth(buffer)
+    #define CEREAL_INSTRUMENT_BYTES(bytes)                ::cereal::detail::CountBytes(bytes)
+    #define CEREAL_INSTRUMENT_NODES(nodes)                ::cereal::detail::CountNodes(nodes)
+#else
+    #define CEREAL_INSTRUMENT_OPERATION(operation, phase) static_cast<void>(0)
+    #define CEREAL_INSTRUMENT_RESULT(bytes)               static_cast<void>(0)
+    #define CEREAL_INSTRUMENT_PHASE(phase)                static_cast<void>(0)
+    #define CEREAL_INSTRUMENT_CAPTURE(context)            static_cast<void>(0)
+    #define CEREAL_INSTRUMENT_ATTACH(context)             static_cast<void>(0)
+    #define CEREAL_INSTRUMENT_ALLOCATION(bytes)           static_cast<void>(0)
+    #define CEREAL_INSTRUMENT_GROWTH(buffer)              static_cast<void>(0)
+    #define CEREAL_INSTRUMENT_BYTES(bytes)                static_cast<void>(0)
+    #define CEREAL_INSTRUMENT_NODES(nodes)                static_cast<void>(0)
+#endif
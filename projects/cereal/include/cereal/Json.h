@@ -24,226 +24,401 @@
 #pragma once
 
 #include "Serializer.h"
+#include "Value.h"
+#include "ValueMap.h"
+#include "Writer.h"
 
 #include <unordered_map>
 #include <vector>
 #include <memory>
-#include <variant>
+#include <memory_resource>
 #include <span>
-#include <typeinfo>
+#include <stdexcept>
 
-#pragma region Preprocessor Macros
+namespace cereal
+{
 
-#ifdef _DEBUG
+class JsonObject;
+class JsonPointer;
+class LazyObject;
+class ThreadPool;
 
-    #if defined(__GNUG__) // GCC / Clang
-        #include <cxxabi.h>
-        #include <cstdlib>
+template<>
+std::string Serialize<std::shared_ptr<JsonObject>>(const std::shared_ptr<JsonObject>& obj);
 
-        #define DEMANGLE_NAME(name)                                                                                              \
-            int         status    = 0;                                                                                           \
-            char*       demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);                                        \
-            std::string result    = (status == 0) ? demangled : name;                                                            \
-            free(demangled);                                                                                                     \
-            return result
+template<>
+struct Serializer<std::shared_ptr<JsonObject>>;
 
-    #elif defined(_MSC_VER) // MSVC
-        #define WIN32_LEAN_AND_MEAN
-        #include <windows.h>
-        #include <dbghelp.h>
+template<>
+struct Serializer<JsonObject>;
 
-        #pragma comment(lib, "dbghelp.lib")
+template<>
+struct BinarySerializer<JsonObject>;
 
-inline std::string DemangleTypeName(const char* name)
+namespace detail
 {
-    if (char demangled[1024]; UnDecorateSymbolName(name, demangled, sizeof(demangled), UNDNAME_COMPLETE))
-    {
-        return std::string(demangled);
-    }
-    return name; // If demangling fails, return raw name
-}
+class JsonParser;
+
+// Anything a member can be looked up by: text, a HashedKey or a Symbol
+template<typename Key>
+concept MemberKey = std::is_convertible_v<const Key&, std::string_view>;
 
-        #define DEMANGLE_NAME(name)                                                                                              \
-            if (char demangled[1024]; UnDecorateSymbolName(name, demangled, sizeof(demangled), UNDNAME_COMPLETE))                \
-            {                                                                                                                    \
-                return std::string(demangled);                                                                                   \
-            }                                                                                                                    \
-            return name // If demangling fails, return raw name
-
-    #else // Fallback
-        #define DEMANGLE_NAME(name) return name
-    #endif
-#else
-    #define DEMANGLE_NAME(name) return name
-#endif
-
-template<typename T>
-std::string GetTypeName()
+// What JsonObject::WriteCached wrote for an object the last time, minus its nested objects, members and array
+// elements alike. Those are written from their own caches at the offsets recorded in splices
+struct OutputCache
 {
-    DEMANGLE_NAME(typeid(T).name());
-}
+    struct Splice
+    {
+        size_t            offset;
+        const JsonObject* child;
+        bool              element = false; // Array elements are always written compact
+    };
 
+    std::string         text;
+    std::vector<Splice> splices;
+    bool                filled      = false;
+    uint64_t            version     = 0;
+    bool                pretty      = false;
+    int                 indentLevel = 0;
+    int                 indentSize  = 0;
+};
 
-#define MAP_TYPE_HELPER(T)  std::unordered_map<std::string, T>
-#define SPAN_TYPE_HELPER(T) std::span<T>
-#define VEC_TYPE_HELPER(T)  std::vector<T>
-#define GET_TYPE(x)         x
+// A cache belongs to the object it was made for, so a copy of the object starts out without one
+class OutputCacheHolder
+{
+public:
+    OutputCacheHolder() = default;
+    OutputCacheHolder(const OutputCacheHolder& /*other*/) {}
+    OutputCacheHolder(OutputCacheHolder&& other) noexcept = default;
 
-#define APPLY_MACRO_TO_TYPE(macro, type) macro(type)
+    OutputCacheHolder& operator=(const OutputCacheHolder& /*other*/)
+    {
+        mCache.reset();
+        return *this;
+    }
 
-// clang-format off
-#define TYPE_VARIANTS(macro, T)                              \
-    APPLY_MACRO_TO_TYPE(macro, T),                           \
-    APPLY_MACRO_TO_TYPE(macro, std::shared_ptr<T>)           \
+    OutputCacheHolder& operator=(OutputCacheHolder&& other) noexcept = default;
 
-#define APPLY_MACRO(macro)                                   \
-    TYPE_VARIANTS(macro, int),                               \
-    TYPE_VARIANTS(macro, bool),                              \
-    TYPE_VARIANTS(macro, double),                            \
-    TYPE_VARIANTS(macro, float),                             \
-    TYPE_VARIANTS(macro, char),                              \
-    TYPE_VARIANTS(macro, std::string),                       \
-    TYPE_VARIANTS(macro, JsonObject)
-// clang-format on
+    [[nodiscard]] OutputCache& Get()
+    {
+        if (!mCache)
+        {
+            mCache = std::make_unique<OutputCache>();
+        }
+        return *mCache;
+    }
 
+private:
+    std::unique_ptr<OutputCache> mCache;
+};
+} // namespace detail
 
-#define TYPES APPLY_MACRO(MAP_TYPE_HELPER), APPLY_MACRO(SPAN_TYPE_HELPER), APPLY_MACRO(GET_TYPE) // APPLY_MACRO(VEC_TYPE_HELPER)
+// How PrintToFile gets the document onto disk
+enum class FileIo : uint8_t
+{
+    Stream, // Through a std::ofstream
+    Direct  // Each chunk the writer flushes goes straight to the OS, without passing through a stream's own buffer
+};
 
-#define VARIANT std::variant<TYPES, std::nullptr_t>
+// Lets maps keyed on any string type be searched with a std::string_view, a std::string or a literal without first
+// building a key of the map's own string type
+struct StringHash
+{
+    using is_transparent = void;
 
-#pragma endregion Preprocessor Macros
+    size_t operator()(const std::string_view key) const { return std::hash<std::string_view>{}(key); }
+};
 
-namespace cereal
+struct StringEqual
 {
+    using is_transparent = void;
 
-class JsonObject;
-
-template<>
-std::string Serialize<std::shared_ptr<JsonObject>>(const std::shared_ptr<JsonObject>& obj);
+    bool operator()(const std::string_view lhs, const std::string_view rhs) const { return lhs == rhs; }
+};
 
 class JsonObject
 {
 public:
-    using JsonValue                          = VARIANT;
-    JsonObject()                             = default;
-    JsonObject(const JsonObject&)            = default;
-    JsonObject& operator=(const JsonObject&) = default;
-
-    void Add(const std::string& key, JsonValue value);
+    using JsonValue = cereal::JsonValue;
+    using ValueMap  = cereal::ValueMap;
+
+    JsonObject() = default;
+
+    // Keys, member storage and everything else the object allocates come from resource, which has to outlive the object.
+    // Copies of the object go back to the default resource
+    explicit JsonObject(std::pmr::memory_resource* resource) : mValues(resource), mOwnedArrays(resource) {}
+
+    JsonObject(const JsonObject&)                = default;
+    JsonObject(JsonObject&&) noexcept            = default;
+    JsonObject& operator=(const JsonObject&)     = default;
+    JsonObject& operator=(JsonObject&&) noexcept = default;
+
+    // Reads a json document whose root is an object. Nested objects become std::shared_ptr<JsonObject>, integers that
+    // fit in an int become int, every other number becomes double. Arrays must hold a single type and are stored as
+    // spans over storage owned by the object they were read into. Throws std::runtime_error on malformed input
+    [[nodiscard]] static JsonObject Parse(std::string_view json,
+                                          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    [[nodiscard]] static JsonObject ParseFile(std::string_view filename,
+                                              std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Like ParseFile, but maps the file instead of reading it into memory. Keys and strings point straight into the
+    // mapping, or into a decoded copy the document keeps for those with escapes, so every string has to be read with
+    // Get<std::string_view>, Get<std::string> throws for all of them. The document and every object in it keep the
+    // mapping alive, and the file must not be changed while it is mapped. Values copied out of the document into
+    // another one own their strings
+    [[nodiscard]] static JsonObject MapFile(std::string_view filename,
+                                            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Reads a MessagePack or CBOR document whose root is a map, following the same rules as Parse. Packed arrays of
+    // int, float and double are copied straight into the array, other packed arrays are read as int or double
+    [[nodiscard]] static JsonObject FromBinary(std::string_view bytes, BinaryFormat format,
+                                               std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    [[nodiscard]] std::pmr::memory_resource* GetResource() const { return mValues.get_allocator().resource(); }
+
+    // An empty object allocated from, and allocating from, the same memory resource as this one. This is how nested
+    // objects should be made when building a document inside a JsonArena
+    [[nodiscard]] std::shared_ptr<JsonObject> CreateObject() const;
+
+    // Strings and nested objects are allocated from this object's resource. Adding with a Symbol costs no allocation
+    // for the key, and the key is written as the symbol's ready made fragment
+    template<typename T, detail::MemberKey Key>
+        requires detail::Storable<T> || std::is_same_v<std::decay_t<T>, JsonValue>
+    void Add(const Key& key, T&& value)
+    {
+        Slot(key).Assign(std::forward<T>(value), GetResource());
+        MarkDirty();
+    }
 
-    void PrintToFile(const std::string_view filename, bool pretty = false, int indentSize = 4) const;
+    void PrintToFile(std::string_view filename, bool pretty = false, int indentSize = 4, FileIo io = FileIo::Stream) const;
 
     [[nodiscard]] std::string ToString(bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
 
+    // Appends this object to the writer's buffer. Nested objects are written in place rather than being
+    // stringified separately and copied into their parent
+    void Write(JsonWriter& writer, bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
+
+    // Same output as ToString and Write, byte for byte, but wide objects and long arrays are cut into chunks that the
+    // pool's threads format side by side before they are joined back up in order. Only worth it for large documents
+    [[nodiscard]] std::string ToString(ThreadPool& pool, bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
+
+    void Write(JsonWriter& writer, ThreadPool& pool, bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
+
+    // Same output as ToString and Write again, but every object keeps what it wrote the last time and only formats
+    // itself again once it has been changed through Add, operator[] or a JsonProxy. Nested objects are written from
+    // their own caches in between, so a change costs formatting the object it was made in, and an object shared by
+    // several parents is formatted once for all of them (once per depth, when pretty printing).
+    //
+    // The caches hold about one more copy of the output. Objects in arrays are written from their own caches too, so
+    // changing one is noticed, but writes straight into an array's span aren't, replacing an object in it included.
+    // Call MarkDirty on the object holding the array after making them. Not safe to call on the same objects from
+    // several threads at once
+    [[nodiscard]] std::string ToStringCached(bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
+
+    void WriteCached(JsonWriter& writer, bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
+
+    // Makes the next WriteCached format this object again
+    void MarkDirty() { ++mVersion; }
+
+    // Byte stable output, laid out as described for CanonicalOutput. Documents holding the same members write the same
+    // bytes whatever order the members were added in, so the result can be hashed or compared as it is
+    [[nodiscard]] std::string ToCanonicalString() const;
+
+    void WriteCanonical(JsonWriter& writer) const;
+
+    [[nodiscard]] std::string ToBinary(BinaryFormat format) const;
+
+    void WriteBinary(BinaryWriter& writer) const;
+
     friend std::ostream& operator<<(std::ostream& os, const JsonObject& obj)
     {
         os << obj.ToString();
         return os;
     }
 
-    [[nodiscard]] const std::unordered_map<std::string, JsonValue>& GetValues() const { return mValues; }
+    [[nodiscard]] const ValueMap& GetValues() const { return mValues; }
 
-    template<typename T>
-    [[nodiscard]] const T& Get(const std::string& key) const
+    // Every lookup below takes a std::string_view, a literal or a std::string without building a temporary key. A
+    // HashedKey skips hashing the key in large objects and a Symbol is found by address
+    template<typename T, detail::MemberKey Key>
+    [[nodiscard]] decltype(auto) Get(const Key& key) const
     {
-        const auto it = mValues.find(key);
-        if (it == mValues.end())
-        {
-            throw std::runtime_error("Key not found in JsonObject: " + key);
-        }
-
-        if (!std::holds_alternative<T>(it->second))
-        {
-            const std::string expectedType = GetTypeName<T>();
-
-            const std::string actualType =
-                std::visit([]<typename P>(const P&) -> std::string { return GetTypeName<std::decay_t<P>>(); }, it->second);
-
-            throw std::runtime_error("Type mismatch: Expected '" + expectedType + "', but found '" + actualType +
-                                     "' for key: " + key);
-        }
-
-        return std::get<T>(mValues.at(key));
+        return Find(key).template Get<T>(key);
     }
 
-    template<typename T>
-    [[nodiscard]] const std::span<T>& GetSpan(const std::string& key) const
+    template<typename T, detail::MemberKey Key>
+    [[nodiscard]] std::span<T> GetSpan(const Key& key) const
     {
         return Get<std::span<T>>(key);
     }
 
-    [[nodiscard]] const std::shared_ptr<JsonObject>& GetObjectPtr(const std::string& key) const
+    template<detail::MemberKey Key>
+    [[nodiscard]] const std::shared_ptr<JsonObject>& GetObjectPtr(const Key& key) const
     {
         return Get<std::shared_ptr<JsonObject>>(key);
     }
 
-    [[nodiscard]] const JsonObject& GetObject(const std::string& key) const { return *GetObjectPtr(key); }
+    template<detail::MemberKey Key>
+    [[nodiscard]] const JsonObject& GetObject(const Key& key) const
+    {
+        return *GetObjectPtr(key);
+    }
+
+    // What every lookup throws when key isn't there, for anything else that looks members up the way JsonObject does
+    [[noreturn]] static void ThrowKeyNotFound(std::string_view key);
 
     #pragma region Json Proxy
 
+    // Refers straight to a member's value and to the key it was looked up with, so it must not outlive either that key
+    // or the next key added to the same object
     class JsonProxy
     {
     public:
-        JsonProxy(JsonValue& value, const std::string& key) : mValue(value), mKey(key) {}
+        JsonProxy(JsonObject& owner, JsonValue& value, const std::string_view key) :
+            mOwner(owner), mValue(value), mKey(key)
+        {}
 
         template<typename T>
         JsonProxy& operator=(const T& value)
         {
-            mValue = value;
+            mValue.Assign(value, mOwner.GetResource());
+            mOwner.MarkDirty();
             return *this;
         }
 
         template<typename T>
         operator T() const
         {
-            if (!std::holds_alternative<T>(mValue))
-            {
-                const std::string expectedType = GetTypeName<T>();
-
-                const std::string actualType =
-                    std::visit([]<typename P>(const P&) -> std::string { return GetTypeName<std::decay_t<P>>(); }, mValue);
+            return mValue.Get<T>(mKey);
+        }
 
-                throw std::runtime_error("Type mismatch: Expected '" + expectedType + "', but found '" + actualType +
-                                         "' for key: " + mKey);
-            }
-            return std::get<T>(mValue);
+        template<detail::MemberKey Key>
+        JsonProxy operator[](const Key& key)
+        {
+            const std::shared_ptr<JsonObject>& child = mValue.Get<std::shared_ptr<JsonObject>>(mKey);
+            return JsonProxy(*child, child->Slot(key), key);
         }
 
-        JsonProxy operator[](const std::string& key) const
+        // What a const JsonObject hands out only looks keys up, so reading through it changes nothing
+        template<detail::MemberKey Key>
+        const JsonProxy operator[](const Key& key) const
         {
-            return JsonProxy(std::get<std::shared_ptr<JsonObject>>(mValue)->mValues[key], key);
+            const std::shared_ptr<JsonObject>& child = mValue.Get<std::shared_ptr<JsonObject>>(mKey);
+            return JsonProxy(*child, const_cast<JsonValue&>(child->Find(key)), key);
         }
 
     private:
-        JsonValue&         mValue;
-        const std::string& mKey;
+        JsonObject&      mOwner;
+        JsonValue&       mValue;
+        std::string_view mKey;
     };
 
     #pragma endregion Json Proxy
 
-    JsonProxy operator[](const std::string& key) { return JsonProxy(mValues[key], key); }
+    template<detail::MemberKey Key>
+    JsonProxy operator[](const Key& key)
+    {
+        return JsonProxy(*this, Slot(key), key);
+    }
+
+    template<detail::MemberKey Key>
+    const JsonProxy operator[](const Key& key) const
+    {
+        return JsonProxy(const_cast<JsonObject&>(*this), const_cast<JsonValue&>(Find(key)), key);
+    }
 
-    const JsonProxy operator[](const std::string& key) const
+private:
+    friend class detail::JsonParser;
+    friend class JsonPointer;
+    friend class LazyObject;
+
+    // The value stored under key, default constructed first if the key is new. Only a new key counts as changing the
+    // object, whoever writes to the value calls MarkDirty after
+    JsonValue& Slot(std::string_view key);
+    JsonValue& Slot(const HashedKey& key);
+    JsonValue& Slot(const Symbol& key);
+
+    // The value stored under key. Throws std::runtime_error if there is none
+    template<typename Key>
+    [[nodiscard]] const JsonValue& Find(const Key& key) const
     {
         const auto it = mValues.find(key);
         if (it == mValues.end())
         {
-            throw std::runtime_error("Key not found in JsonObject: " + key);
+            ThrowKeyNotFound(key);
         }
-        return JsonProxy(const_cast<JsonValue&>(it->second), key);
+        return it->second;
     }
 
-private:
-    static std::string Indent(const size_t level, const size_t indentSize = 4) { return std::string(level * indentSize, ' '); }
+    // The same, but a new key points at key's characters instead of copying them
+    JsonValue& ViewSlot(std::string_view key);
+
+    // Writes this object laid out as Output, splitting it up across pool when there is one. With a cache, nested objects
+    // are left out and where they go is recorded in it instead
+    template<typename Output>
+    void WriteObject(JsonWriter& writer, ThreadPool* pool, int indentLevel, int indentSize,
+                     detail::OutputCache* cache = nullptr) const;
+
+    // Writes one member, preceded by a separator unless it is the first
+    template<typename Output>
+    static void WriteMember(JsonWriter& writer, const ValueMap::value_type& member, bool separator, ThreadPool* pool,
+                            int indentLevel, int indentSize, detail::OutputCache* cache);
 
 private:
-    std::unordered_map<std::string, JsonValue> mValues;
+    ValueMap mValues;
+
+    // Bumped by every change, so WriteCached can tell whether its cache is still current
+    uint64_t                          mVersion = 0;
+    mutable detail::OutputCacheHolder mCache;
+
+    // Backing storage for spans this object owns rather than views, such as arrays read by Parse, and the mapping that
+    // keys and strings read by MapFile point into
+    std::pmr::vector<std::shared_ptr<void>> mOwnedArrays;
+};
+
+template<>
+struct Serializer<JsonObject>
+{
+    static void Write(std::string& out, const JsonObject& obj)
+    {
+        JsonWriter writer(out);
+        obj.Write(writer);
+    }
+
+    static std::string Serialize(const JsonObject& obj) { return obj.ToString(); }
+};
+
+template<>
+struct Serializer<std::shared_ptr<JsonObject>>
+{
+    static void Write(std::string& out, const std::shared_ptr<JsonObject>& obj)
+    {
+        if (!obj)
+        {
+            WriteItem(out, nullptr);
+            return;
+        }
+        Serializer<JsonObject>::Write(out, *obj);
+    }
+
+    static std::string Serialize(const std::shared_ptr<JsonObject>& obj)
+    {
+        std::string out;
+        Write(out, obj);
+        return out;
+    }
+};
+
+template<>
+struct BinarySerializer<JsonObject>
+{
+    static void Write(BinaryWriter& out, const JsonObject& obj) { obj.WriteBinary(out); }
 };
 
 template<>
 inline std::string Serialize<std::shared_ptr<JsonObject>>(const std::shared_ptr<JsonObject>& obj)
 {
-    return obj->ToString();
+    return Serializer<std::shared_ptr<JsonObject>>::Serialize(obj);
 }
 
 
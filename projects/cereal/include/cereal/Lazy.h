@@ -0,0 +1,206 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Lazy.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Json.h"
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace cereal
+{
+
+class LazyObject;
+
+namespace detail
+{
+struct LazyState;
+
+// The type Parse would have stored for what a lazy accessor hands out, for the tags and names in type mismatches
+template<typename T>
+struct LazyStoredOf
+{
+    using Type = T;
+};
+
+template<>
+struct LazyStoredOf<LazyObject>
+{
+    using Type = std::shared_ptr<JsonObject>;
+};
+
+template<>
+struct LazyStoredOf<std::span<LazyObject>>
+{
+    using Type = std::span<std::shared_ptr<JsonObject>>;
+};
+
+template<typename T>
+using LazyStored = typename LazyStoredOf<T>::Type;
+} // namespace detail
+
+// One object inside a LazyDocument. Nothing in it is parsed until it is asked for: a lookup walks the structural
+// index over the object's keys only, jumping over the values of every other member, however large, in one step.
+//
+// The accessors mirror JsonObject's and follow the same rules as Parse, so a value has the type Parse would have
+// given it and asking for anything else throws the same std::runtime_error. Everything is returned by value: numbers
+// and bools are parsed on every call, strings without escapes are views into the input, and nested objects are
+// LazyObjects of their own. Arrays are parsed the first time they are read and kept by the document after that.
+//
+// Every lookup walks the keys again, so an object that is read from over and over is better off materialized. A handle
+// is only valid as long as the document it came from. When a key appears more than once the first one is found, where
+// Parse would keep the last
+class LazyObject
+{
+public:
+    LazyObject() = default;
+
+    template<typename T>
+    [[nodiscard]] T Get(const std::string_view key) const
+    {
+        const uint32_t cursor = Locate(key);
+        if constexpr (std::is_same_v<T, LazyObject>)
+        {
+            if (IsObject(cursor))
+            {
+                return LazyObject(mState, cursor);
+            }
+        } else if constexpr (detail::TypeOf<detail::LazyStored<T>> == JsonType::Span)
+        {
+            using Element = typename T::element_type;
+            void*  data   = nullptr;
+            size_t size   = 0;
+            if (ReadArray(cursor, detail::TypeOf<detail::LazyStored<Element>>, data, size))
+            {
+                return T(static_cast<Element*>(data), size);
+            }
+        } else
+        {
+            JsonValue value;
+            if (ReadScalar(cursor, value))
+            {
+                if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+                {
+                    if (value.GetType() == JsonType::StringView)
+                    {
+                        return T(value.Get<std::string_view>());
+                    }
+                } else if (value.Holds<T>())
+                {
+                    return value.Get<T>();
+                }
+            }
+        }
+        ThrowTypeMismatch(cursor, GetTypeName<detail::LazyStored<T>>(), key);
+    }
+
+    template<typename T>
+    [[nodiscard]] std::span<T> GetSpan(const std::string_view key) const
+    {
+        return Get<std::span<T>>(key);
+    }
+
+    [[nodiscard]] LazyObject GetObject(const std::string_view key) const { return Get<LazyObject>(key); }
+
+    [[nodiscard]] bool Contains(std::string_view key) const;
+
+    // Member count. Walks every key, but still skips over every value
+    [[nodiscard]] size_t Size() const;
+
+    // The object's text, exactly as it appears in the input
+    [[nodiscard]] std::string_view Raw() const;
+
+    // Parses the whole object into a JsonObject
+    [[nodiscard]] JsonObject Materialize(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+protected:
+    LazyObject(const detail::LazyState* state, const uint32_t open) : mState(state), mOpen(open) {}
+
+private:
+    friend struct detail::LazyState;
+
+    static constexpr uint32_t NotFound = UINT32_MAX;
+
+    // Structural index entry of the value stored under key, or NotFound
+    [[nodiscard]] uint32_t Find(std::string_view key) const;
+
+    // The same, but throws std::runtime_error as JsonObject does if the key isn't there
+    [[nodiscard]] uint32_t Locate(std::string_view key) const;
+
+    [[nodiscard]] bool IsObject(uint32_t cursor) const;
+
+    // Reads a number, bool, null or string. Strings are viewed, either in the input or, if they had escapes, in a
+    // decoded copy the document keeps. Returns false for objects and arrays
+    bool ReadScalar(uint32_t cursor, JsonValue& value) const;
+
+    // Elements of the array at cursor, parsed on first use. Returns false if they aren't of type element
+    bool ReadArray(uint32_t cursor, JsonType element, void*& data, size_t& size) const;
+
+    [[noreturn]] void ThrowTypeMismatch(uint32_t cursor, const std::string& expectedType, std::string_view key) const;
+
+private:
+    const detail::LazyState* mState = nullptr;
+    uint32_t                 mOpen  = 0; // Structural index entry of the object's '{'
+};
+
+// Raw json plus its structural index and, for every '{' and '[', where the matching bracket is. Building that is a
+// single pass over the input and allocates two arrays of offsets, no matter how many members the document has. The
+// document is its own root object.
+//
+// Bracket nesting and strings are checked up front, the rest of the syntax only where it is read, so malformed json
+// in a part that is never read can go unnoticed. Reading from several threads at once is safe
+class LazyDocument : public LazyObject
+{
+public:
+    // Copies json
+    [[nodiscard]] static LazyDocument Parse(std::string_view json);
+
+    // Refers to json, which has to outlive the document and every object taken from it
+    [[nodiscard]] static LazyDocument View(std::string_view json);
+
+    [[nodiscard]] static LazyDocument ParseFile(std::string_view filename);
+
+    // Maps the file instead of reading it. The file must not be changed while the document is open
+    [[nodiscard]] static LazyDocument MapFile(std::string_view filename);
+
+    ~LazyDocument();
+    LazyDocument(LazyDocument&& other) noexcept;
+    LazyDocument& operator=(LazyDocument&& other) noexcept;
+
+    LazyDocument(const LazyDocument&)            = delete;
+    LazyDocument& operator=(const LazyDocument&) = delete;
+
+private:
+    explicit LazyDocument(std::unique_ptr<detail::LazyState> state);
+
+private:
+    std::unique_ptr<detail::LazyState> mOwned;
+};
+
+} // namespace cereal
@@ -0,0 +1,282 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Ndjson.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Json.h"
+#include "ThreadPool.h"
+#include "Writer.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cereal
+{
+
+namespace detail
+{
+
+class FileOutput;
+
+// Counts durations into buckets about 6% wide so percentiles can be read off at any point in fixed memory, however many
+// batches have gone through
+class LatencyHistogram
+{
+public:
+    void Record(std::chrono::nanoseconds duration);
+
+    // Upper bound of the bucket holding the given fraction (0-1) of the recorded durations, in seconds
+    [[nodiscard]] double Percentile(double fraction) const;
+
+private:
+    static constexpr size_t SubBuckets = 16;
+
+    std::array<uint64_t, 64 * SubBuckets> mBuckets{};
+    uint64_t                              mCount = 0;
+};
+
+} // namespace detail
+
+// Throughput of an NdjsonWriter or NdjsonReader so far
+struct NdjsonStats
+{
+    uint64_t records = 0;
+    uint64_t batches = 0;
+    uint64_t bytes   = 0;
+    double   seconds = 0.0; // wall time spent on those records
+
+    double p50BatchSeconds = 0.0;
+    double p99BatchSeconds = 0.0;
+
+    [[nodiscard]] double RecordsPerSecond() const { return seconds > 0.0 ? static_cast<double>(records) / seconds : 0.0; }
+};
+
+// Writes records as newline delimited json, one compact document per line. Records are cut into batches that the
+// pool's threads format side by side, and a dedicated thread hands the finished batches to the OS in order while the
+// next ones are being formatted.
+//
+// Batch buffers are reused, and there are never more than maxBatches of them: once they are all formatted and waiting
+// to be written, Write blocks until the output catches up. Memory stays bounded however many records go through.
+//
+// A record can be a JsonObject, anything with a Serialize() that returns a std::shared_ptr<JsonObject> (such as a
+// cereal::Serializable), anything cereal::Serializer can write, or a pointer to any of those. Records are formatted on
+// several threads at once, so writing one must not touch anything another one writes
+class NdjsonWriter
+{
+public:
+    static constexpr size_t DefaultBatchRecords = 1024;
+
+    // maxBatches of 0 means two per pool thread, enough for one set to be written while the next is formatted
+    NdjsonWriter(int descriptor, ThreadPool& pool, size_t batchRecords = DefaultBatchRecords, size_t maxBatches = 0);
+
+    // Creates or truncates the file
+    NdjsonWriter(std::string_view filename, ThreadPool& pool, size_t batchRecords = DefaultBatchRecords,
+                 size_t maxBatches = 0);
+
+    // Writes whatever is still queued. Errors are lost at this point, call Flush first to see them
+    ~NdjsonWriter();
+
+    NdjsonWriter(const NdjsonWriter&)            = delete;
+    NdjsonWriter& operator=(const NdjsonWriter&) = delete;
+
+    // If writing a record throws, the exception comes out of Write and none of the records formatted alongside it are
+    // written. Records from earlier batches of the same call may already have been
+    template<std::ranges::random_access_range Range>
+    void Write(Range&& records)
+    {
+        const size_t count = std::ranges::size(records);
+        const auto   first = std::ranges::begin(records);
+
+        for (size_t done = 0; done < count;)
+        {
+            const std::vector<Batch*>& batches = Acquire((count - done + mBatchRecords - 1) / mBatchRecords);
+
+            try
+            {
+                mPool.ForEach(batches.size(), [&](const size_t i) {
+                    Batch&       batch = *batches[i];
+                    const size_t begin = done + i * mBatchRecords;
+                    const size_t end   = (std::min)(begin + mBatchRecords, count);
+
+                    batch.start   = Clock::now();
+                    batch.records = end - begin;
+                    batch.text.clear();
+
+                    JsonWriter writer(batch.text);
+                    for (size_t r = begin; r < end; ++r)
+                    {
+                        WriteRecord(writer, first[static_cast<std::iter_difference_t<decltype(first)>>(r)]);
+                        writer.Append('\n');
+                    }
+                });
+            } catch (...)
+            {
+                Release();
+                throw;
+            }
+
+            done = (std::min)(done + batches.size() * mBatchRecords, count);
+            Submit();
+        }
+    }
+
+    // Blocks until everything handed to Write is with the OS. Throws std::runtime_error if any write failed
+    void Flush();
+
+    [[nodiscard]] NdjsonStats GetStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Batch
+    {
+        std::string       text;
+        size_t            records = 0;
+        Clock::time_point start;
+    };
+
+    template<typename T>
+    static void WriteRecord(JsonWriter& writer, T& record)
+    {
+        using Record = std::remove_cvref_t<T>;
+
+        if constexpr (std::is_same_v<Record, JsonObject>)
+        {
+            record.Write(writer);
+        } else if constexpr (requires { { record.Serialize() } -> std::convertible_to<std::shared_ptr<JsonObject>>; })
+        {
+            const std::shared_ptr<JsonObject> object = record.Serialize();
+            WriteRecord(writer, object);
+        } else if constexpr (requires { record == nullptr; *record; })
+        {
+            if (record == nullptr)
+            {
+                writer.AppendValue(nullptr);
+            } else
+            {
+                WriteRecord(writer, *record);
+            }
+        } else
+        {
+            writer.AppendValue(record);
+        }
+    }
+
+    void Start(size_t maxBatches);
+
+    // Up to wanted free batches, waiting for at least one if none are free
+    const std::vector<Batch*>& Acquire(size_t wanted);
+
+    // Queues the batches from the last Acquire for output, in order
+    void Submit();
+
+    // Hands the batches from the last Acquire back unwritten
+    void Release();
+
+    void OutputLoop();
+
+private:
+    ThreadPool&                         mPool;
+    size_t                              mBatchRecords;
+    std::unique_ptr<detail::FileOutput> mOutput;
+
+    std::vector<std::unique_ptr<Batch>> mBatches;
+    std::vector<Batch*>                 mAcquired;
+
+    mutable std::mutex      mMutex;
+    std::condition_variable mQueued;   // the output thread has work
+    std::condition_variable mReturned; // a batch is free again
+    std::vector<Batch*>     mFree;
+    std::deque<Batch*>      mQueue;
+    bool                    mStop = false;
+    std::exception_ptr      mError;
+
+    NdjsonStats              mStats;
+    detail::LatencyHistogram mLatency;
+    Clock::time_point        mFirstWrite;
+    bool                     mStarted = false;
+
+    std::thread mThread;
+};
+
+// Reads newline delimited json, one JsonObject per line. The input is cut into chunks at line boundaries, each chunk is
+// parsed on one of the pool's threads, and the records are handed over in input order one window of chunks at a time,
+// so only a window's worth of records is ever held in memory.
+//
+// Every line must hold an object. Blank lines are skipped and a \r before the \n is ignored
+class NdjsonReader
+{
+public:
+    static constexpr size_t DefaultChunkSize = 256 * 1024;
+
+    using Handler = std::function<void(JsonObject& record)>;
+
+    explicit NdjsonReader(ThreadPool& pool, size_t chunkSize = DefaultChunkSize) : mPool(pool), mChunkSize(chunkSize) {}
+
+    // Calls handler with every record in order. The handler may move from the record. A line that fails to parse
+    // throws std::runtime_error naming the line, once every record before it has been handed over
+    void Read(std::string_view ndjson, const Handler& handler);
+
+    // Same as Read, over a mapped file
+    void ReadFile(std::string_view filename, const Handler& handler);
+
+    [[nodiscard]] NdjsonStats GetStats() const;
+
+private:
+    struct Chunk
+    {
+        std::vector<JsonObject> records;
+        size_t                  lines     = 0;
+        size_t                  errorLine = 0; // 1 based line within the chunk that failed to parse, 0 if none did
+        std::string             error;
+    };
+
+    // First line start at or after offset, where start is known to begin a line
+    [[nodiscard]] static size_t LineStart(std::string_view ndjson, size_t start, size_t offset);
+
+    static void ParseChunk(std::string_view text, Chunk& chunk);
+
+private:
+    ThreadPool&        mPool;
+    size_t             mChunkSize;
+    std::vector<Chunk> mChunks;
+
+    NdjsonStats              mStats;
+    detail::LatencyHistogram mLatency;
+};
+
+} // namespace cereal
@@ -0,0 +1,243 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Pointer.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Json.h"
+#include "Symbol.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace cereal
+{
+
+// Where a JsonPointer leads: a member's value, or one element of the span or array that value holds. Empty when the
+// pointer leads nowhere. Only valid until the document it points into is changed
+class JsonTarget
+{
+public:
+    static constexpr size_t WholeValue = SIZE_MAX;
+
+    JsonTarget() = default;
+
+    [[nodiscard]] bool Found() const { return mValue != nullptr; }
+    explicit           operator bool() const { return Found(); }
+
+    // The member's value, which holds the span or array when the target is one of its elements
+    [[nodiscard]] const JsonValue* Value() const { return mValue; }
+
+    // Index of the element within the value, or WholeValue
+    [[nodiscard]] size_t Element() const { return mElement; }
+
+    // Reads the target the way JsonValue::Get does, or a single element when it is one. Throws std::runtime_error if
+    // the target is empty or holds something else
+    template<typename T>
+    [[nodiscard]] decltype(auto) Get() const
+    {
+        if (!mValue)
+        {
+            throw std::runtime_error("JSON pointer target not found");
+        }
+
+        if constexpr (detail::IsSpanElement<T>)
+        {
+            if (mElement != WholeValue)
+            {
+                return static_cast<const T&>(mValue->Get<std::span<T>>()[mElement]);
+            }
+        }
+        return mValue->Get<T>();
+    }
+
+private:
+    friend class JsonPointer;
+
+    JsonTarget(JsonObject* owner, JsonValue* value, const size_t element) : mOwner(owner), mValue(value), mElement(element)
+    {}
+
+private:
+    JsonObject* mOwner   = nullptr; // Object the value is a member of
+    JsonValue*  mValue   = nullptr;
+    size_t      mElement = WholeValue;
+};
+
+// An RFC 6901 JSON Pointer such as "/child/3dcoord/x" or "/samples/3", split up and unescaped once so it can be
+// evaluated over and over. Every reference token keeps the hash of its key and, when it is one, the array index it
+// spells, so following the pointer costs one lookup per level and never hashes or parses anything.
+//
+// Tokens step into nested objects, held by std::shared_ptr or inline, and into spans and arrays, whose elements are
+// addressed by index. A token is always a key when it steps into an object, even if it is made of digits. The empty
+// pointer "" refers to the document itself, which isn't a value Resolve, Get or Set can hand out
+class JsonPointer
+{
+public:
+    static constexpr size_t NotAnIndex = SIZE_MAX;
+
+    // Throws std::runtime_error if pointer isn't a valid JSON Pointer
+    explicit JsonPointer(std::string_view pointer);
+
+    // The pointer as it was given
+    [[nodiscard]] const std::string& ToString() const { return mText; }
+
+    [[nodiscard]] size_t Size() const { return mTokens.size(); }
+
+    // The unescaped token at index, "~1" and "~0" turned back into "/" and "~"
+    [[nodiscard]] std::string_view Token(const size_t index) const { return mTokens[index].text; }
+
+    // The array index the token at index spells, or NotAnIndex if it can only be a key
+    [[nodiscard]] size_t Index(const size_t index) const { return mTokens[index].index; }
+
+    // The pointer's text up to the end of its first count tokens
+    [[nodiscard]] std::string_view Prefix(const size_t count) const
+    {
+        return std::string_view(mText).substr(0, count == 0 ? 0 : mTokens[count - 1].end);
+    }
+
+    // Throws the std::runtime_error for a pointer whose first found tokens lead somewhere and the next one doesn't
+    [[noreturn]] void ThrowNotFound(size_t found) const;
+
+    // Where the pointer leads in root. The target is empty when a member along the way is missing, an index is out of
+    // range or a value that isn't an object, span or array has to be stepped into
+    [[nodiscard]] JsonTarget Resolve(const JsonObject& root) const;
+
+    // Throws std::runtime_error naming the pointer when it leads nowhere or to something other than T
+    template<typename T>
+    [[nodiscard]] decltype(auto) Get(const JsonObject& root) const
+    {
+        const JsonTarget target = Resolve(root);
+        if (!target)
+        {
+            ThrowNotFound(root);
+        }
+        return target.Get<T>();
+    }
+
+    // Writes value where the pointer leads, in place. Everything up to the last token has to be there already. The last
+    // token adds a member when the object has none under it, or overwrites one element of a span or array, in which
+    // case value has to be of the element type. Either way the change is noticed by JsonObject::WriteCached
+    template<typename T>
+        requires detail::Storable<T> || std::is_same_v<std::decay_t<T>, JsonValue>
+    void Set(JsonObject& root, T&& value) const
+    {
+        const Container parent = Parent(root);
+        const Entry&    last   = mTokens.back();
+        if (parent.object)
+        {
+            parent.object->Slot(HashedKey(last.text, last.hash)).Assign(std::forward<T>(value), parent.object->GetResource());
+            parent.object->MarkDirty();
+            return;
+        }
+
+        using Element = std::conditional_t<detail::IsStringLike<std::decay_t<T>>, std::string, std::decay_t<T>>;
+        if constexpr (detail::IsSpanElement<Element>)
+        {
+            const std::span<Element> elements = parent.array->Get<std::span<Element>>(mText);
+            if (last.index >= elements.size())
+            {
+                ThrowNotFound(root);
+            }
+            elements[last.index] = std::forward<T>(value);
+            parent.owner->MarkDirty();
+        } else
+        {
+            throw std::runtime_error("JSON pointer " + mText + " leads to an array element, which can't hold a " +
+                                     GetTypeName<std::decay_t<T>>());
+        }
+    }
+
+private:
+    friend class JsonPointerSet;
+
+    struct Entry
+    {
+        std::string text;
+        uint64_t    hash  = 0;
+        size_t      index = NotAnIndex; // The array index the token spells, if it spells one
+        size_t      end   = 0;          // Where the token ends in the pointer's text
+    };
+
+    // An object, or a span or array that is a member of owner, for the next token to step into
+    struct Container
+    {
+        JsonObject* object = nullptr;
+        JsonValue*  array  = nullptr;
+        JsonObject* owner  = nullptr;
+    };
+
+    [[nodiscard]] static JsonTarget Step(const Container& container, const Entry& token);
+    [[nodiscard]] static Container  Enter(const JsonTarget& target);
+
+    // How many tokens lead somewhere in root, and where the last of them leads
+    size_t Walk(const JsonObject& root, JsonTarget& target) const;
+
+    // What the last token steps into. Throws std::runtime_error if anything before it can't be followed
+    [[nodiscard]] Container Parent(JsonObject& root) const;
+
+    [[noreturn]] void ThrowNotFound(const JsonObject& root) const;
+
+private:
+    std::string        mText;
+    std::vector<Entry> mTokens;
+};
+
+// Many pointers resolved together in a single walk over the document. Pointers that share a prefix share the lookups
+// for it, so reading a dozen fields out of the same nested object looks that object up once rather than a dozen times
+class JsonPointerSet
+{
+public:
+    JsonPointerSet();
+
+    // Returns the position the pointer's target takes in what Resolve fills in
+    size_t Add(const JsonPointer& pointer);
+    size_t Add(std::string_view pointer) { return Add(JsonPointer(pointer)); }
+
+    [[nodiscard]] size_t Size() const { return mCount; }
+
+    // Fills targets with where every pointer leads in root, in the order they were added
+    void Resolve(const JsonObject& root, std::vector<JsonTarget>& targets) const;
+
+    [[nodiscard]] std::vector<JsonTarget> Resolve(const JsonObject& root) const;
+
+private:
+    struct Node
+    {
+        JsonPointer::Entry    token;
+        std::vector<uint32_t> children;
+        std::vector<uint32_t> pointers; // Positions of the pointers that end here
+    };
+
+    void Resolve(const Node& node, const JsonPointer::Container& container, std::vector<JsonTarget>& targets) const;
+
+private:
+    std::vector<Node> mNodes; // mNodes[0] stands for the document itself
+    size_t            mCount = 0;
+};
+
+} // namespace cereal
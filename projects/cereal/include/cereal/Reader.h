@@ -0,0 +1,199 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Reader.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cereal
+{
+
+// Where JsonReader pulls its input from, one chunk at a time
+class JsonSource
+{
+public:
+    JsonSource()                                       = default;
+    virtual ~JsonSource()                              = default;
+    JsonSource(const JsonSource& other)                = default;
+    JsonSource(JsonSource&& other) noexcept            = default;
+    JsonSource& operator=(const JsonSource& other)     = default;
+    JsonSource& operator=(JsonSource&& other) noexcept = default;
+
+    // Copies up to size bytes into buffer and returns how many were copied. Returning 0 means the input is exhausted
+    virtual size_t Read(char* buffer, size_t size) = 0;
+};
+
+class StreamSource : public JsonSource
+{
+public:
+    explicit StreamSource(std::istream& stream) : mStream(stream) {}
+
+    size_t Read(char* buffer, size_t size) override;
+
+private:
+    std::istream& mStream;
+};
+
+class StringSource : public JsonSource
+{
+public:
+    explicit StringSource(const std::string_view json) : mJson(json) {}
+
+    size_t Read(char* buffer, size_t size) override;
+
+private:
+    std::string_view mJson;
+};
+
+// Callbacks for JsonReader::Parse. Every callback returns what the reader should do next: keep going, skip the value
+// that was just announced (the value after a key, or the rest of an object/array that was just started) or stop
+class JsonHandler
+{
+public:
+    enum class Action
+    {
+        Continue,
+        Skip,
+        Stop
+    };
+
+    JsonHandler()                                        = default;
+    virtual ~JsonHandler()                               = default;
+    JsonHandler(const JsonHandler& other)                = default;
+    JsonHandler(JsonHandler&& other) noexcept            = default;
+    JsonHandler& operator=(const JsonHandler& other)     = default;
+    JsonHandler& operator=(JsonHandler&& other) noexcept = default;
+
+    virtual Action StartObject() { return Action::Continue; }
+    virtual Action EndObject() { return Action::Continue; }
+    virtual Action StartArray() { return Action::Continue; }
+    virtual Action EndArray() { return Action::Continue; }
+    virtual Action Key(std::string_view /*key*/) { return Action::Continue; }
+    virtual Action String(std::string_view /*value*/) { return Action::Continue; }
+    virtual Action Integer(int64_t /*value*/) { return Action::Continue; }
+    virtual Action Double(double /*value*/) { return Action::Continue; }
+    virtual Action Bool(bool /*value*/) { return Action::Continue; }
+    virtual Action Null() { return Action::Continue; }
+};
+
+// Pull style json reader that never holds more than a fixed size window of the input plus one entry per level of
+// nesting, so documents of any size can be read in bounded memory. The window only grows when a single string or number
+// is larger than it.
+//
+// Call Next() for one event at a time, or Parse() to feed every event to a JsonHandler. Keys and strings returned by
+// GetString() point into the window and stay valid until the next call to Next()
+class JsonReader
+{
+public:
+    static constexpr size_t DefaultWindowSize = 64 * 1024;
+
+    enum class Event
+    {
+        StartObject,
+        EndObject,
+        StartArray,
+        EndArray,
+        Key,
+        String,
+        Integer,
+        Double,
+        Bool,
+        Null,
+        EndOfDocument
+    };
+
+    explicit JsonReader(JsonSource& source, size_t windowSize = DefaultWindowSize);
+
+    Event Next();
+
+    // Skips the value following the last Key event, or the rest of the object/array started by the last event, without
+    // decoding any of it
+    void SkipValue();
+
+    // Runs through the rest of the document. Returns false if the handler stopped early
+    bool Parse(JsonHandler& handler);
+
+    [[nodiscard]] std::string_view GetString() const { return mString; }
+    [[nodiscard]] int64_t          GetInteger() const { return mInteger; }
+    [[nodiscard]] double           GetDouble() const { return mDouble; }
+    [[nodiscard]] bool             GetBool() const { return mBool; }
+
+    [[nodiscard]] size_t Depth() const { return mStack.size(); }
+
+    // Offset into the input of the next byte the reader will look at
+    [[nodiscard]] size_t Offset() const { return mConsumed + mPos; }
+
+private:
+    enum class Expect
+    {
+        Value,
+        ValueOrArrayEnd,
+        KeyOrObjectEnd,
+        Key,
+        Colon,
+        CommaOrEnd,
+        Done
+    };
+
+    [[noreturn]] void Error(std::string_view message) const;
+
+    Event NextEvent();
+
+    bool Fill();
+    bool Available(size_t count);
+    bool SkipWhitespace();
+
+    Event ReadValue(char c);
+    Event ReadEnd(char c);
+    void  ReadString();
+    Event ReadNumber();
+    bool  ParsesAsInteger(const char* first, const char* last);
+    Event ReadLiteral(std::string_view literal, Event event);
+
+    void AfterValue();
+
+private:
+    JsonSource&       mSource;
+    std::vector<char> mBuffer;
+    size_t            mPos      = 0;
+    size_t            mEnd      = 0;
+    size_t            mConsumed = 0;
+    bool              mEof      = false;
+
+    std::vector<char> mStack; // '{' or '[' for every open container
+    Expect            mExpect   = Expect::Value;
+    Event             mLast     = Event::EndOfDocument;
+    bool              mSkipping = false;
+
+    std::string_view mString;
+    std::string      mScratch; // holds strings that had to be unescaped
+    int64_t          mInteger = 0;
+    double           mDouble  = 0.0;
+    bool             mBool    = false;
+};
+
+} // namespace cereal
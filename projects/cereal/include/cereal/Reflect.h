@@ -0,0 +1,175 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Reflect.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Serializer.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#pragma region Preprocessor Macros
+
+// CEREAL_FOR_EACH(macro, a, b, c) expands to macro(a), macro(b), macro(c), for up to 32 arguments. CEREAL_EXPAND
+// forces MSVC's traditional preprocessor to split __VA_ARGS__ back into separate arguments
+
+// clang-format off
+#define CEREAL_EXPAND(x) x
+
+#define CEREAL_FOR_EACH_1(macro, x) macro(x)
+#define CEREAL_FOR_EACH_2(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_1(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_3(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_2(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_4(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_3(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_5(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_4(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_6(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_5(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_7(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_6(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_8(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_7(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_9(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_8(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_10(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_9(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_11(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_10(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_12(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_11(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_13(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_12(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_14(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_13(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_15(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_14(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_16(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_15(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_17(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_16(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_18(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_17(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_19(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_18(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_20(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_19(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_21(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_20(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_22(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_21(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_23(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_22(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_24(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_23(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_25(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_24(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_26(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_25(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_27(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_26(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_28(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_27(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_29(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_28(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_30(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_29(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_31(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_30(macro, __VA_ARGS__))
+#define CEREAL_FOR_EACH_32(macro, x, ...) macro(x), CEREAL_EXPAND(CEREAL_FOR_EACH_31(macro, __VA_ARGS__))
+
+#define CEREAL_FOR_EACH_PICK(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19,       \
+    _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, name, ...) name
+
+#define CEREAL_FOR_EACH(macro, ...)                                                                                      \
+    CEREAL_EXPAND(CEREAL_FOR_EACH_PICK(__VA_ARGS__,                                                                      \
+        CEREAL_FOR_EACH_32, CEREAL_FOR_EACH_31, CEREAL_FOR_EACH_30, CEREAL_FOR_EACH_29, CEREAL_FOR_EACH_28,              \
+        CEREAL_FOR_EACH_27, CEREAL_FOR_EACH_26, CEREAL_FOR_EACH_25, CEREAL_FOR_EACH_24, CEREAL_FOR_EACH_23,              \
+        CEREAL_FOR_EACH_22, CEREAL_FOR_EACH_21, CEREAL_FOR_EACH_20, CEREAL_FOR_EACH_19, CEREAL_FOR_EACH_18,              \
+        CEREAL_FOR_EACH_17, CEREAL_FOR_EACH_16, CEREAL_FOR_EACH_15, CEREAL_FOR_EACH_14, CEREAL_FOR_EACH_13,              \
+        CEREAL_FOR_EACH_12, CEREAL_FOR_EACH_11, CEREAL_FOR_EACH_10, CEREAL_FOR_EACH_9, CEREAL_FOR_EACH_8,                \
+        CEREAL_FOR_EACH_7, CEREAL_FOR_EACH_6, CEREAL_FOR_EACH_5, CEREAL_FOR_EACH_4, CEREAL_FOR_EACH_3,                   \
+        CEREAL_FOR_EACH_2, CEREAL_FOR_EACH_1)(macro, __VA_ARGS__))
+// clang-format on
+
+// One descriptor per member. The key is stored already quoted, with the ": " after it and the ", " that separates it
+// from the previous member, so writing a key is a single append of a string literal
+#define CEREAL_FIELD_DESCRIPTOR(member) ::cereal::MakeField(", \"" #member "\": ", &CerealDescribedType::member)
+
+// Lists the members of a struct that are written to, and read from, json. Goes inside the struct, after the members:
+//
+//     struct Vector2
+//     {
+//         float x = 0.0f;
+//         float y = 0.0f;
+//
+//         CEREAL_DESCRIBE(Vector2, x, y)
+//     };
+//
+// Members are written in the order they are listed. Any member type with a Serializer works, including other
+// described types and containers of them
+#define CEREAL_DESCRIBE(Type, ...)                                                                                       \
+    using CerealDescribedType = Type;                                                                                    \
+    static constexpr auto CerealFields()                                                                                 \
+    {                                                                                                                    \
+        return std::make_tuple(CEREAL_FOR_EACH(CEREAL_FIELD_DESCRIPTOR, __VA_ARGS__));                                   \
+    }
+
+#pragma endregion Preprocessor Macros
+
+namespace cereal
+{
+
+template<typename Owner, typename T>
+struct Field
+{
+    using OwnerType  = Owner;
+    using MemberType = T;
+
+    std::string_view prefix; // , "name":
+    T Owner::*       member;
+
+    // The prefix to write when this is the first member of the object
+    [[nodiscard]] constexpr std::string_view FirstPrefix() const { return prefix.substr(2); }
+    [[nodiscard]] constexpr std::string_view Name() const { return prefix.substr(3, prefix.size() - 6); }
+};
+
+template<typename Owner, typename T>
+constexpr Field<Owner, T> MakeField(const std::string_view prefix, T Owner::*member)
+{
+    return { prefix, member };
+}
+
+template<typename T>
+concept Described = requires { T::CerealFields(); };
+
+// Writes a described struct member by member straight into out, without building a JsonObject
+template<Described T>
+void WriteFields(std::string& out, const T& value)
+{
+    static constexpr auto fields = T::CerealFields();
+
+    CEREAL_INSTRUMENT_NODES(std::tuple_size_v<decltype(fields)>);
+
+    out += '{';
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (
+            [&] {
+                constexpr auto field = std::get<I>(fields);
+                out += I == 0 ? field.FirstPrefix() : field.prefix;
+                Serializer<typename decltype(field)::MemberType>::Write(out, value.*field.member);
+            }(),
+            ...);
+    }(std::make_index_sequence<std::tuple_size_v<decltype(fields)>>{});
+    out += '}';
+}
+
+template<Described T>
+struct Serializer<T>
+{
+    static void Write(std::string& out, const T& value) { WriteFields(out, value); }
+
+    static std::string Serialize(const T& value)
+    {
+        std::string out;
+        WriteFields(out, value);
+        return out;
+    }
+};
+
+} // namespace cereal
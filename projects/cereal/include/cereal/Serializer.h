@@ -23,174 +23,375 @@
 
 #pragma once
 
+#include "Escape.h"
+#include "Instrument.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <array>
-#include <iomanip>
+#include <limits>
 #include <ostream>
 #include <sstream>
 #include <unordered_map>
 #include <variant>
 #include <span>
 
+// Number of significant digits used when writing floats and doubles. 0 (the default) writes the shortest
+// representation that reads back as exactly the same value
 #ifndef CEREAL_FLT_PRECISION
-    #define CEREAL_FLT_PRECISION std::numeric_limits<float>::digits10
+    #define CEREAL_FLT_PRECISION 0
 #endif
 
 #ifndef CEREAL_DBL_PRECISION
-    #define CEREAL_DBL_PRECISION std::numeric_limits<double>::digits10
+    #define CEREAL_DBL_PRECISION 0
 #endif
 
 namespace cereal
 {
 
 template<typename T>
-std::string SerializeItem(const T& obj)
+struct Serializer;
+
+#pragma region Number Formatting
+
+// Formats value into [first, last) and returns one past the last character written. last - first must be at least
+// MaxNumberWidth<T>
+template<typename T>
+char* FormatNumber(char* first, char* last, const T value, [[maybe_unused]] const int precision = 0)
 {
-    std::ostringstream oss;
-    oss << obj;
-    return oss.str();
+    static_assert(std::is_arithmetic_v<T>, "FormatNumber only supports arithmetic types");
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        // Json has no representation for nan or infinity
+        if (!std::isfinite(value))
+        {
+            constexpr std::string_view null = "null";
+            return std::copy(null.begin(), null.end(), first);
+        }
+
+        if (precision > 0)
+        {
+            const int digits = (std::min)(precision, std::numeric_limits<T>::max_digits10);
+            return std::to_chars(first, last, value, std::chars_format::general, digits).ptr;
+        }
+    }
+    return std::to_chars(first, last, value).ptr;
 }
 
-template<>
-inline std::string SerializeItem<std::string>(const std::string& obj)
+// Large enough for any integer and for the longest floating point value to_chars can produce at max_digits10
+template<typename T>
+constexpr size_t MaxNumberWidth = std::is_floating_point_v<T> ? 32 : std::numeric_limits<T>::digits10 + 3;
+
+template<typename T>
+void WriteNumber(std::string& out, const T value, const int precision = 0)
+{
+    char buffer[MaxNumberWidth<T>];
+    out.append(buffer, FormatNumber(buffer, buffer + sizeof(buffer), value, precision));
+}
+
+// How CanonicalOutput writes numbers: integers as they are, floating point values at the shortest precision that reads
+// back exactly, and negative zero as 0
+template<typename T>
+void WriteCanonicalNumber(std::string& out, const T value)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (value == 0)
+        {
+            out += '0';
+            return;
+        }
+    }
+    WriteNumber(out, value);
+}
+
+// The precision WriteItem uses for T
+template<typename T>
+constexpr int DefaultPrecision = std::is_same_v<T, float> ? CEREAL_FLT_PRECISION
+                               : std::is_same_v<T, double> ? CEREAL_DBL_PRECISION
+                                                           : 0;
+
+// Writes a whole array of numbers in one pass. Rather than formatting every element into a temporary and appending
+// it, the output grows once per chunk of elements and each one is formatted straight into place
+template<typename T>
+void WriteNumbers(std::string& out, const T* values, const size_t count, const int precision = DefaultPrecision<T>)
 {
-    return "\"" + obj + "\"";
+    constexpr size_t Width     = MaxNumberWidth<T> + 2; // ", " before every element but the first
+    constexpr size_t ChunkSize = 256;
+
+    out += '[';
+    for (size_t first = 0; first < count; first += ChunkSize)
+    {
+        const size_t last  = (std::min)(first + ChunkSize, count);
+        const size_t start = out.size();
+        out.resize(start + (last - first) * Width);
+
+        char*       cursor = out.data() + start;
+        char* const end    = out.data() + out.size();
+        for (size_t i = first; i < last; ++i)
+        {
+            if (i != 0)
+            {
+                *cursor++ = ',';
+                *cursor++ = ' ';
+            }
+            cursor = FormatNumber(cursor, end, values[i], precision);
+        }
+        out.resize(static_cast<size_t>(cursor - out.data()));
+    }
+    out += ']';
+}
+
+inline void WriteBools(std::string& out, const bool* values, const size_t count)
+{
+    constexpr size_t Width = sizeof("false, ") - 1;
+
+    const size_t start = out.size();
+    out.resize(start + 2 + count * Width);
+
+    char* cursor = out.data() + start;
+    *cursor++    = '[';
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i != 0)
+        {
+            *cursor++ = ',';
+            *cursor++ = ' ';
+        }
+        const std::string_view text = values[i] ? std::string_view("true") : std::string_view("false");
+        cursor                      = std::copy(text.begin(), text.end(), cursor);
+    }
+    *cursor++ = ']';
+    out.resize(static_cast<size_t>(cursor - out.data()));
+}
+
+#pragma endregion Number Formatting
+
+#pragma region Write Functions
+
+// The Write* functions append the json representation of a value to the end of out. They are what the writer
+// uses internally, the Serialize* functions further down are convenience wrappers that return a new string
+
+template<typename T>
+void WriteItem(std::string& out, const T& obj)
+{
+    if constexpr (std::is_arithmetic_v<T>)
+    {
+        WriteNumber(out, obj);
+    } else
+    {
+        std::ostringstream oss;
+        oss << obj;
+        out += oss.str();
+    }
+}
+
+inline void WriteItem(std::string& out, const std::string_view obj)
+{
+    WriteEscapedString(out, obj);
 }
 
 template<>
-inline std::string SerializeItem<char>(const char& obj)
+inline void WriteItem<std::string>(std::string& out, const std::string& obj)
 {
-    return "\"" + std::string(1, obj) + "\"";
+    WriteItem(out, std::string_view{ obj });
 }
 
 template<>
-inline std::string SerializeItem<bool>(const bool& obj)
+inline void WriteItem<char>(std::string& out, const char& obj)
 {
-    return obj ? "true" : "false";
+    WriteItem(out, std::string_view{ &obj, 1 });
 }
 
 template<>
-inline std::string SerializeItem<float>(const float& obj)
+inline void WriteItem<bool>(std::string& out, const bool& obj)
 {
-    std::ostringstream oss;
-    oss << std::setprecision(CEREAL_FLT_PRECISION) << obj;
-    return oss.str();
+    out += obj ? "true" : "false";
 }
 
 template<>
-inline std::string SerializeItem<double>(const double& obj)
+inline void WriteItem<float>(std::string& out, const float& obj)
 {
-    std::ostringstream oss;
-    oss << std::setprecision(CEREAL_DBL_PRECISION) << obj;
-    return oss.str();
+    WriteNumber(out, obj, DefaultPrecision<float>);
 }
 
 template<>
-inline std::string SerializeItem<std::nullptr_t>(const std::nullptr_t&)
+inline void WriteItem<double>(std::string& out, const double& obj)
 {
-    return "null";
+    WriteNumber(out, obj, DefaultPrecision<double>);
 }
 
+template<>
+inline void WriteItem<std::nullptr_t>(std::string& out, const std::nullptr_t&)
+{
+    out += "null";
+}
 
 template<typename T>
-std::string SerializeItem(const std::string_view key, const T& value)
+void WriteItem(std::string& out, const std::string_view key, const T& value)
 {
-    const std::string jsonValue = SerializeItem(value);
-    return "\"" + std::string(key) + "\": " + jsonValue;
+    WriteItem(out, key);
+    out += ": ";
+    Serializer<T>::Write(out, value);
 }
 
-template<typename T, size_t N>
-std::string SerializeArray(const std::array<T, N> arr)
+template<typename It>
+void WriteRange(std::string& out, It first, It last)
 {
-    std::ostringstream oss;
-    oss << "[";
-    for (size_t i = 0; i < N; ++i)
+    using T = std::decay_t<decltype(*first)>;
+
+    CEREAL_INSTRUMENT_NODES(static_cast<size_t>(std::distance(first, last)));
+
+    // Contiguous numbers and bools go through the bulk kernels. char is written as a one character string, not a
+    // number, so it takes the generic path
+    if constexpr (std::contiguous_iterator<It> && std::is_same_v<T, bool>)
+    {
+        WriteBools(out, std::to_address(first), static_cast<size_t>(last - first));
+    } else if constexpr (std::contiguous_iterator<It> && std::is_arithmetic_v<T> && !std::is_same_v<T, char>)
+    {
+        WriteNumbers(out, std::to_address(first), static_cast<size_t>(last - first));
+    } else
     {
-        oss << cereal::SerializeItem(arr[i]);
-        if (i != N - 1)
+        out += '[';
+        for (It it = first; it != last; ++it)
         {
-            oss << ", ";
+            if (it != first)
+            {
+                out += ", ";
+            }
+            Serializer<T>::Write(out, *it);
         }
+        out += ']';
     }
-    oss << "]";
-    return oss.str();
+}
+
+template<typename T, size_t N>
+void WriteArray(std::string& out, const std::array<T, N>& arr)
+{
+    WriteRange(out, arr.begin(), arr.end());
 }
 
 template<typename T>
-std::string SerializeVector(const std::vector<T>& vec)
+void WriteVector(std::string& out, const std::vector<T>& vec)
 {
-    std::ostringstream oss;
-    oss << "[";
-    for (size_t i = 0; i < vec.size(); ++i)
+    WriteRange(out, vec.begin(), vec.end());
+}
+
+template<typename T>
+void WriteSpan(std::string& out, const std::span<T> vec)
+{
+    WriteRange(out, vec.begin(), vec.end());
+}
+
+template<typename T>
+void WriteMap(std::string& out, const std::unordered_map<std::string, T>& map)
+{
+    CEREAL_INSTRUMENT_NODES(map.size());
+
+    out += '{';
+    bool first = true;
+    for (const auto& [key, value] : map)
     {
-        oss << cereal::SerializeItem(vec[i]);
-        if (i != vec.size() - 1)
+        if (!first)
         {
-            oss << ", ";
+            out += ", ";
         }
+        WriteItem(out, key, value);
+        first = false;
     }
-    oss << "]";
-    return oss.str();
+    out += '}';
+}
+
+#pragma endregion Write Functions
+
+template<typename T>
+std::string SerializeItem(const T& obj)
+{
+    std::string out;
+    WriteItem(out, obj);
+    return out;
+}
+
+template<typename T>
+std::string SerializeItem(const std::string_view key, const T& value)
+{
+    std::string out;
+    WriteItem(out, key, value);
+    return out;
+}
+
+template<typename T, size_t N>
+std::string SerializeArray(const std::array<T, N> arr)
+{
+    std::string out;
+    WriteArray(out, arr);
+    return out;
+}
+
+template<typename T>
+std::string SerializeVector(const std::vector<T>& vec)
+{
+    std::string out;
+    WriteVector(out, vec);
+    return out;
 }
 
 template<typename T>
 std::string SerializeSpan(const std::span<T> vec)
 {
-    std::ostringstream oss;
-    oss << "[";
-    for (size_t i = 0; i < vec.size(); ++i)
-    {
-        oss << cereal::SerializeItem(vec[i]);
-        if (i != vec.size() - 1)
-        {
-            oss << ", ";
-        }
-    }
-    oss << "]";
-    return oss.str();
+    std::string out;
+    WriteSpan(out, vec);
+    return out;
 }
 
 template<typename T>
 std::string SerializeMap(const std::unordered_map<std::string, T>& map)
 {
-    std::ostringstream oss;
-    oss << "{";
-    size_t i = 0;
-    for (const auto& [key, value] : map)
-    {
-        oss << cereal::SerializeItem(key, value);
-        if (i != map.size() - 1)
-        {
-            oss << ", ";
-        }
-        ++i;
-    }
-    oss << "}";
-    return oss.str();
+    std::string out;
+    WriteMap(out, map);
+    return out;
 }
 
 template<typename T>
 struct Serializer
 {
+    static void        Write(std::string& out, const T& obj) { WriteItem(out, obj); }
     static std::string Serialize(const T& obj) { return SerializeItem(obj); }
 };
 
 template<typename T>
 struct Serializer<std::vector<T>>
 {
+    static void        Write(std::string& out, const std::vector<T>& obj) { WriteVector(out, obj); }
     static std::string Serialize(const std::vector<T>& obj) { return SerializeVector(obj); }
 };
 
+template<typename T, size_t N>
+struct Serializer<std::array<T, N>>
+{
+    static void        Write(std::string& out, const std::array<T, N>& obj) { WriteArray(out, obj); }
+    static std::string Serialize(const std::array<T, N>& obj) { return SerializeArray(obj); }
+};
+
 template<typename T>
 struct Serializer<std::unordered_map<std::string, T>>
 {
+    static void        Write(std::string& out, const std::unordered_map<std::string, T>& obj) { WriteMap(out, obj); }
     static std::string Serialize(const std::unordered_map<std::string, T>& obj) { return SerializeMap(obj); }
 };
 
 template<typename T>
 struct Serializer<std::span<T>>
 {
+    static void        Write(std::string& out, const std::span<T> obj) { WriteSpan(out, obj); }
     static std::string Serialize(const std::span<T> obj) { return SerializeSpan(obj); }
 };
 
@@ -200,17 +401,26 @@ struct Serializer<std::variant<Ts...>>;
 template<typename T>
 std::string Serialize(const T& obj)
 {
-    return Serializer<T>::Serialize(obj);
+    CEREAL_INSTRUMENT_OPERATION(Operation::Serialize, Phase::Walk);
+
+    std::string out = Serializer<T>::Serialize(obj);
+    CEREAL_INSTRUMENT_RESULT(out.size());
+    return out;
 }
 
 template<typename... Ts>
 struct Serializer<std::variant<Ts...>>
 {
+    static void Write(std::string& out, const std::variant<Ts...>& obj)
+    {
+        std::visit([&out]<typename T>(const T& val) { Serializer<T>::Write(out, val); }, obj);
+    }
+
     static std::string Serialize(const std::variant<Ts...>& obj)
     {
-        std::ostringstream oss;
-        std::visit([&oss](const auto& val) { oss << Serialize(val); }, obj);
-        return oss.str();
+        std::string out;
+        Write(out, obj);
+        return out;
     }
 };
 
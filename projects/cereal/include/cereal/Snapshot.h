@@ -0,0 +1,186 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Snapshot.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Json.h"
+#include "Pointer.h"
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace cereal
+{
+
+namespace detail
+{
+struct SnapshotNode;
+
+// A member of a snapshot: either a value or a nested object. Both are immutable and shared by every version of the
+// document that didn't change them
+struct SnapshotMember
+{
+    std::shared_ptr<const JsonValue>    value;
+    std::shared_ptr<const SnapshotNode> object;
+};
+} // namespace detail
+
+// An immutable version of a JsonObject. Copying a snapshot copies one pointer, and changing it leaves it as it is and
+// hands back a new version that shares every object off the changed path with the old one, so keeping a history of a
+// large document costs only what changed between versions.
+//
+// Building one from a JsonObject copies the whole document once. Everything is copied deep, spans and string views
+// included, so the snapshot owns all it holds and nothing done to the JsonObject afterwards can reach it. Objects held
+// inline come back as std::shared_ptr<JsonObject> from Materialize.
+//
+// Updates walk down the path, copying each object on it. Objects keep their members in chunks of ChunkSize, and an
+// update copies the list of chunks plus the chunk holding the member, so even a very wide object along the path costs a
+// fraction of its width. Adding or erasing a member copies the object's keys as well. Arrays are values like any
+// other and are replaced whole. Spans handed out by Get must not be written through.
+//
+// Lookups follow JsonObject's rules and throw the same std::runtime_error. A snapshot can be read, copied and updated
+// from several threads at once
+class JsonSnapshot
+{
+public:
+    static constexpr size_t ChunkSize = 32;
+
+    // An empty object
+    JsonSnapshot();
+
+    explicit JsonSnapshot(const JsonObject& object);
+
+    template<typename T>
+    [[nodiscard]] decltype(auto) Get(const std::string_view key) const
+    {
+        return Value<T>(Locate(key), key);
+    }
+
+    template<typename T>
+    [[nodiscard]] std::span<T> GetSpan(const std::string_view key) const
+    {
+        return Get<std::span<T>>(key);
+    }
+
+    // The nested object as a snapshot of its own, sharing everything with this one
+    [[nodiscard]] JsonSnapshot GetObject(std::string_view key) const;
+
+    // Reads what path leads to. The last token may index into an array. Throws std::runtime_error naming the pointer
+    // when it leads nowhere or to something other than T
+    template<typename T>
+    [[nodiscard]] decltype(auto) Get(const JsonPointer& path) const
+    {
+        size_t                        element = JsonTarget::WholeValue;
+        const detail::SnapshotMember& member  = Locate(path, element);
+        if constexpr (detail::IsSpanElement<T>)
+        {
+            if (element != JsonTarget::WholeValue)
+            {
+                return static_cast<const T&>(Value<std::span<T>>(member, path.ToString())[element]);
+            }
+        }
+        return Value<T>(member, path.ToString());
+    }
+
+    [[nodiscard]] JsonSnapshot GetObject(const JsonPointer& path) const;
+
+    [[nodiscard]] bool Contains(std::string_view key) const;
+
+    [[nodiscard]] size_t Size() const;
+
+    // The version with value stored where path leads. Every object up to the last token has to be there already, the
+    // last token adds a member when there isn't one under it. Storing a JsonObject or a JsonSnapshot stores an object
+    template<typename T>
+        requires detail::Storable<T> || std::is_same_v<std::decay_t<T>, JsonValue>
+    [[nodiscard]] JsonSnapshot Set(const JsonPointer& path, T&& value) const
+    {
+        return Replace(path, MakeMember(JsonValue(std::forward<T>(value))));
+    }
+
+    [[nodiscard]] JsonSnapshot Set(const JsonPointer& path, const JsonSnapshot& object) const;
+
+    // The same for a member of this object
+    template<typename T>
+        requires detail::Storable<T> || std::is_same_v<std::decay_t<T>, JsonValue>
+    [[nodiscard]] JsonSnapshot Set(const std::string_view key, T&& value) const
+    {
+        return Replace(key, MakeMember(JsonValue(std::forward<T>(value))));
+    }
+
+    [[nodiscard]] JsonSnapshot Set(std::string_view key, const JsonSnapshot& object) const;
+
+    // The version without the member path leads to. Throws std::runtime_error if there is no such member
+    [[nodiscard]] JsonSnapshot Erase(const JsonPointer& path) const;
+    [[nodiscard]] JsonSnapshot Erase(std::string_view key) const;
+
+    // True when both are the very same version of an object, which is how unchanged parts can be skipped when two
+    // versions are compared. Objects that were built separately are never the same, even if they hold the same members
+    [[nodiscard]] bool SameVersion(const JsonSnapshot& other) const { return mRoot == other.mRoot; }
+
+    // Output is the same as a JsonObject with the same members in the same order would write
+    [[nodiscard]] std::string ToString(bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
+
+    void Write(JsonWriter& writer, bool pretty = false, int indentLevel = 0, int indentSize = 4) const;
+
+    [[nodiscard]] std::string ToCanonicalString() const;
+
+    // A mutable copy of this version
+    [[nodiscard]] JsonObject Materialize(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+private:
+    explicit JsonSnapshot(std::shared_ptr<const detail::SnapshotNode> root) : mRoot(std::move(root)) {}
+
+    template<typename T>
+    [[nodiscard]] static decltype(auto) Value(const detail::SnapshotMember& member, const std::string_view key)
+    {
+        if (!member.value)
+        {
+            ThrowObjectMismatch(GetTypeName<T>(), key);
+        }
+        return member.value->Get<T>(key);
+    }
+
+    // Throws std::runtime_error as JsonObject does if the key isn't there
+    [[nodiscard]] const detail::SnapshotMember& Locate(std::string_view key) const;
+
+    // What path leads to, and the element it picks out of it when the last token indexes into an array
+    [[nodiscard]] const detail::SnapshotMember& Locate(const JsonPointer& path, size_t& element) const;
+
+    // Copies whatever value refers to but doesn't own, and turns objects into snapshots
+    [[nodiscard]] static detail::SnapshotMember MakeMember(JsonValue&& value);
+
+    [[nodiscard]] JsonSnapshot Replace(const JsonPointer& path, detail::SnapshotMember member) const;
+    [[nodiscard]] JsonSnapshot Replace(std::string_view key, detail::SnapshotMember member) const;
+
+    [[noreturn]] static void ThrowObjectMismatch(const std::string& expectedType, std::string_view key);
+
+private:
+    std::shared_ptr<const detail::SnapshotNode> mRoot;
+};
+
+} // namespace cereal
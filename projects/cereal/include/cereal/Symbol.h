@@ -0,0 +1,147 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Symbol.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cereal
+{
+
+namespace detail
+{
+
+// The hash ValueMap indexes keys by. Symbols store theirs so it is only ever worked out once per key
+inline uint64_t HashKey(const std::string_view key)
+{
+    return std::hash<std::string_view>{}(key);
+}
+
+} // namespace detail
+
+// A key whose hash is worked out once up front, for lookups repeated often enough that hashing the key every time
+// shows up. It only refers to the text, which has to outlive it
+class HashedKey
+{
+public:
+    explicit HashedKey(const std::string_view text) : mText(text), mHash(detail::HashKey(text)) {}
+
+    // For a hash worked out earlier from the same text, such as the ones a JsonPointer keeps for its tokens
+    HashedKey(const std::string_view text, const uint64_t hash) : mText(text), mHash(hash) {}
+
+    [[nodiscard]] std::string_view Text() const { return mText; }
+    [[nodiscard]] uint64_t         Hash() const { return mHash; }
+
+    operator std::string_view() const { return mText; }
+
+private:
+    std::string_view mText;
+    uint64_t         mHash;
+};
+
+// A key interned in the SymbolTable. The text and its serialized form, quotes, escapes and the ": " after it included,
+// sit in the same block as the symbol itself, so a member keyed by a symbol costs no allocation of its own and is
+// written with a single append.
+//
+// There is only one symbol per distinct text, so two symbols are equal exactly when they are the same object
+class Symbol
+{
+public:
+    Symbol(const Symbol&)            = delete;
+    Symbol& operator=(const Symbol&) = delete;
+
+    [[nodiscard]] uint32_t         Id() const { return mId; }
+    [[nodiscard]] uint64_t         Hash() const { return mHash; }
+    [[nodiscard]] std::string_view Text() const { return { reinterpret_cast<const char*>(this + 1), mSize }; }
+
+    // "key": as a member of a json object starts
+    [[nodiscard]] std::string_view Fragment() const { return { Text().data() + mSize, mFragmentSize }; }
+
+    operator std::string_view() const { return Text(); }
+
+    // The symbol whose text starts at text, which must have come from Symbol::Text
+    [[nodiscard]] static const Symbol& FromText(const char* text) { return *(reinterpret_cast<const Symbol*>(text) - 1); }
+
+private:
+    friend class SymbolTable;
+
+    Symbol(const uint32_t id, const uint64_t hash, const uint32_t size, const uint32_t fragmentSize) :
+        mHash(hash), mId(id), mSize(size), mFragmentSize(fragmentSize)
+    {}
+
+private:
+    uint64_t mHash;
+    uint32_t mId;
+    uint32_t mSize;
+    uint32_t mFragmentSize;
+};
+
+// Every interned key in the program. Interning is thread safe and symbols are never freed, so they can be held on to
+// anywhere and shared between any number of objects and threads. Intern keys that come up over and over, such as the
+// member names of records, rather than keys read from untrusted input, which would grow the table without bound
+class SymbolTable
+{
+public:
+    [[nodiscard]] static SymbolTable& Global();
+
+    SymbolTable(const SymbolTable&)            = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // The symbol for text, made on first use
+    const Symbol& Intern(std::string_view text);
+
+    // The symbol for text if it has been interned, otherwise nullptr
+    [[nodiscard]] const Symbol* Find(std::string_view text) const;
+
+    // Throws std::out_of_range for an id that was never handed out
+    [[nodiscard]] const Symbol& Get(uint32_t id) const;
+
+    [[nodiscard]] size_t Size() const;
+
+private:
+    SymbolTable() = default;
+
+    struct TextHash
+    {
+        size_t operator()(const std::string_view text) const { return static_cast<size_t>(detail::HashKey(text)); }
+    };
+
+private:
+    mutable std::shared_mutex                                     mMutex;
+    std::vector<const Symbol*>                                    mSymbols; // by id
+    std::unordered_map<std::string_view, const Symbol*, TextHash> mLookup;
+};
+
+// SymbolTable::Global().Intern(text)
+inline const Symbol& Intern(const std::string_view text)
+{
+    return SymbolTable::Global().Intern(text);
+}
+
+} // namespace cereal
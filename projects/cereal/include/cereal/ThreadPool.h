@@ -0,0 +1,93 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: ThreadPool.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cereal
+{
+
+// A fixed set of worker threads for the parallel writers. Work is handed out as the indices of a batch, so splitting a
+// job into pieces costs one atomic increment per piece rather than a queued task each.
+//
+// The calling thread works on every batch alongside the workers, so a pool of size 1 starts no threads at all and runs
+// everything inline
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads that work on a batch, the calling one included
+    [[nodiscard]] unsigned Size() const { return static_cast<unsigned>(mWorkers.size()) + 1; }
+
+    // Calls fn(i) for every i in [0, count) and returns once all of them are done. If any call throws, the rest of the
+    // batch is abandoned and the first exception is rethrown here. fn must not call ForEach on the same pool
+    template<typename Fn>
+    void ForEach(const size_t count, Fn&& fn)
+    {
+        using Target = std::remove_reference_t<Fn>;
+
+        void* const context = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+        Run(count, [](void* target, const size_t index) { (*static_cast<Target*>(target))(index); }, context);
+    }
+
+private:
+    using Task = void (*)(void* context, size_t index);
+
+    void Run(size_t count, Task task, void* context);
+    void Work();
+    void WorkerLoop();
+
+private:
+    std::vector<std::thread> mWorkers;
+
+    std::mutex              mRunMutex; // one batch at a time
+    std::mutex              mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    uint64_t                mGeneration = 0;
+    unsigned                mBusy       = 0; // workers still on the current batch
+    bool                    mStop       = false;
+
+    Task                mTask    = nullptr;
+    void*               mContext = nullptr;
+    size_t              mCount   = 0;
+    std::atomic<size_t> mNext    = 0;
+    std::exception_ptr  mError;
+};
+
+} // namespace cereal
@@ -0,0 +1,684 @@
+﻿// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Value.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Binary.h"
+#include "Serializer.h"
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
+#include <variant>
+
+#pragma region Preprocessor Macros
+
+#ifdef _DEBUG
+
+    #if defined(__GNUG__) // GCC / Clang
+        #include <cxxabi.h>
+        #include <cstdlib>
+
+        #define DEMANGLE_NAME(name)                                                                                              \
+            int         status    = 0;                                                                                           \
+            char*       demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);                                        \
+            std::string result    = (status == 0) ? demangled : name;                                                            \
+            free(demangled);                                                                                                     \
+            return result
+
+    #elif defined(_MSC_VER) // MSVC
+        #define WIN32_LEAN_AND_MEAN
+        #include <windows.h>
+        #include <dbghelp.h>
+
+        #pragma comment(lib, "dbghelp.lib")
+
+inline std::string DemangleTypeName(const char* name)
+{
+    if (char demangled[1024]; UnDecorateSymbolName(name, demangled, sizeof(demangled), UNDNAME_COMPLETE))
+    {
+        return std::string(demangled);
+    }
+    return name; // If demangling fails, return raw name
+}
+
+        #define DEMANGLE_NAME(name)                                                                                              \
+            if (char demangled[1024]; UnDecorateSymbolName(name, demangled, sizeof(demangled), UNDNAME_COMPLETE))                \
+            {                                                                                                                    \
+                return std::string(demangled);                                                                                   \
+            }                                                                                                                    \
+            return name // If demangling fails, return raw name
+
+    #else // Fallback
+        #define DEMANGLE_NAME(name) return name
+    #endif
+#else
+    #define DEMANGLE_NAME(name) return name
+#endif
+
+template<typename T>
+std::string GetTypeName()
+{
+    DEMANGLE_NAME(typeid(T).name());
+}
+
+
+#define MAP_TYPE_HELPER(T)  std::unordered_map<std::string, T>
+#define SPAN_TYPE_HELPER(T) std::span<T>
+#define VEC_TYPE_HELPER(T)  std::vector<T>
+#define GET_TYPE(x)         x
+
+#define APPLY_MACRO_TO_TYPE(macro, type) macro(type)
+
+// clang-format off
+#define TYPE_VARIANTS(macro, T)                              \
+    APPLY_MACRO_TO_TYPE(macro, T),                           \
+    APPLY_MACRO_TO_TYPE(macro, std::shared_ptr<T>)           \
+
+#define APPLY_MACRO(macro)                                   \
+    TYPE_VARIANTS(macro, int),                               \
+    TYPE_VARIANTS(macro, bool),                              \
+    TYPE_VARIANTS(macro, double),                            \
+    TYPE_VARIANTS(macro, float),                             \
+    TYPE_VARIANTS(macro, char),                              \
+    TYPE_VARIANTS(macro, std::string),                       \
+    TYPE_VARIANTS(macro, JsonObject)
+// clang-format on
+
+
+#define TYPES APPLY_MACRO(MAP_TYPE_HELPER), APPLY_MACRO(SPAN_TYPE_HELPER), APPLY_MACRO(VEC_TYPE_HELPER), APPLY_MACRO(GET_TYPE)
+
+#define VARIANT std::variant<TYPES, std::nullptr_t>
+
+#pragma endregion Preprocessor Macros
+
+namespace cereal
+{
+
+class JsonObject;
+
+// What a JsonValue currently holds. Spans and arrays also record the type of their elements using the same tags
+enum class JsonType : uint8_t
+{
+    Null,
+    Bool,
+    Int,
+    Float,
+    Double,
+    Char,
+    String,
+    Object,       // std::shared_ptr<JsonObject>
+    InlineObject, // JsonObject
+    Span,  // std::span<T>, a view over elements owned elsewhere
+    Array, // std::vector<T>, owned by the value
+    Boxed,
+    StringView // std::string_view, characters owned by someone else such as a mapped file
+};
+
+namespace detail
+{
+
+// Every type a JsonValue accepts. This is still the original variant so the set of storable types hasn't changed, it
+// is only used as a list of types now
+using JsonTypeList = VARIANT;
+
+template<typename T, typename List>
+constexpr bool IsAlternative = false;
+
+template<typename T, typename... Ts>
+constexpr bool IsAlternative<T, std::variant<Ts...>> = (std::is_same_v<T, Ts> || ...);
+
+template<typename T>
+constexpr JsonType TypeOf = JsonType::Boxed;
+
+// clang-format off
+template<> constexpr JsonType TypeOf<std::nullptr_t>              = JsonType::Null;
+template<> constexpr JsonType TypeOf<bool>                        = JsonType::Bool;
+template<> constexpr JsonType TypeOf<int>                         = JsonType::Int;
+template<> constexpr JsonType TypeOf<float>                       = JsonType::Float;
+template<> constexpr JsonType TypeOf<double>                      = JsonType::Double;
+template<> constexpr JsonType TypeOf<char>                        = JsonType::Char;
+template<> constexpr JsonType TypeOf<std::string>                 = JsonType::String;
+template<> constexpr JsonType TypeOf<std::string_view>            = JsonType::StringView;
+template<> constexpr JsonType TypeOf<std::shared_ptr<JsonObject>> = JsonType::Object;
+template<> constexpr JsonType TypeOf<JsonObject>                  = JsonType::InlineObject;
+// clang-format on
+
+template<typename T>
+constexpr bool IsSpanElement = TypeOf<T> != JsonType::Null && TypeOf<T> < JsonType::Span;
+
+template<typename T>
+constexpr JsonType TypeOf<std::span<T>> = IsSpanElement<T> ? JsonType::Span : JsonType::Boxed;
+
+template<typename T>
+constexpr JsonType TypeOf<std::vector<T>> = IsSpanElement<T> ? JsonType::Array : JsonType::Boxed;
+
+// Arrays keep the vector they were given so moving one in never copies the elements. std::vector<bool> packs its
+// bits and can't be viewed as a span though, so bool arrays are unpacked into a buffer of their own
+template<typename T>
+using ArrayStorage = std::conditional_t<std::is_same_v<T, bool>, std::unique_ptr<bool[]>, std::vector<T>>;
+
+template<typename T>
+T* ArrayData(const std::vector<T>& storage)
+{
+    return const_cast<T*>(storage.data());
+}
+
+inline bool* ArrayData(const std::unique_ptr<bool[]>& storage)
+{
+    return storage.get();
+}
+
+// Calls fn with a std::type_identity of the element type a span or array tag stands for
+template<typename Fn>
+decltype(auto) WithElementType(const JsonType element, Fn&& fn)
+{
+    switch (element)
+    {
+    case JsonType::Bool: return fn(std::type_identity<bool>{});
+    case JsonType::Int: return fn(std::type_identity<int>{});
+    case JsonType::Float: return fn(std::type_identity<float>{});
+    case JsonType::Double: return fn(std::type_identity<double>{});
+    case JsonType::Char: return fn(std::type_identity<char>{});
+    case JsonType::String: return fn(std::type_identity<std::string>{});
+    case JsonType::InlineObject: return fn(std::type_identity<JsonObject>{});
+    default: return fn(std::type_identity<std::shared_ptr<JsonObject>>{});
+    }
+}
+
+// Literals and string views are stored as std::string
+template<typename T>
+constexpr bool IsStringLike = !std::is_same_v<T, std::nullptr_t> && std::is_convertible_v<const T&, std::string_view>;
+
+template<typename T>
+concept Storable = IsAlternative<std::decay_t<T>, JsonTypeList> || IsStringLike<std::decay_t<T>>;
+
+template<typename T>
+constexpr JsonType StoredTypeOf = IsStringLike<T> ? JsonType::String : TypeOf<T>;
+
+// Strings and objects live out of line in blocks that remember which resource they came from, so the value pointing
+// at them doesn't have to
+template<typename T>
+struct Payload
+{
+    std::pmr::memory_resource* resource;
+    T                          value;
+};
+
+template<typename T, typename... Args>
+Payload<T>* NewPayload(std::pmr::memory_resource* resource, Args&&... args)
+{
+    void* memory = resource->allocate(sizeof(Payload<T>), alignof(Payload<T>));
+    CEREAL_INSTRUMENT_ALLOCATION(sizeof(Payload<T>));
+    try
+    {
+        return new (memory) Payload<T>{ resource, T(std::forward<Args>(args)...) };
+    } catch (...)
+    {
+        resource->deallocate(memory, sizeof(Payload<T>), alignof(Payload<T>));
+        throw;
+    }
+}
+
+template<typename T>
+void DeletePayload(Payload<T>* payload)
+{
+    std::pmr::memory_resource* resource = payload->resource;
+    payload->~Payload<T>();
+    resource->deallocate(payload, sizeof(Payload<T>), alignof(Payload<T>));
+}
+
+// Appends the json value in json the way CanonicalOutput lays values out, whatever order its object members are in
+void WriteCanonicalJson(std::string& out, std::string_view json);
+
+// Everything that isn't one of the common types, such as maps or shared pointers to scalars, is type erased
+struct Box
+{
+    std::pmr::memory_resource* resource = nullptr;
+
+    Box()          = default;
+    virtual ~Box() = default;
+
+    Box(const Box&)            = delete;
+    Box& operator=(const Box&) = delete;
+
+    [[nodiscard]] virtual const std::type_info& TypeId() const                                 = 0;
+    [[nodiscard]] virtual std::string           TypeName() const                               = 0;
+    virtual void                                Write(std::string& out) const                  = 0;
+    virtual void                                WriteBinary(BinaryWriter& out) const           = 0;
+    virtual void                                WriteCanonical(std::string& out) const         = 0;
+    [[nodiscard]] virtual Box*                  Clone(std::pmr::memory_resource* target) const = 0;
+
+    // Destroys the box and hands its memory back to the resource it came from
+    virtual void Destroy() = 0;
+};
+
+template<typename T>
+struct BoxOf final : Box
+{
+    T value;
+
+    template<typename U>
+    explicit BoxOf(U&& v) : value(std::forward<U>(v))
+    {}
+
+    template<typename U>
+    static BoxOf* New(std::pmr::memory_resource* target, U&& v)
+    {
+        void* memory = target->allocate(sizeof(BoxOf), alignof(BoxOf));
+        CEREAL_INSTRUMENT_ALLOCATION(sizeof(BoxOf));
+        try
+        {
+            BoxOf* box    = new (memory) BoxOf(std::forward<U>(v));
+            box->resource = target;
+            return box;
+        } catch (...)
+        {
+            target->deallocate(memory, sizeof(BoxOf), alignof(BoxOf));
+            throw;
+        }
+    }
+
+    [[nodiscard]] const std::type_info& TypeId() const override { return typeid(T); }
+    [[nodiscard]] std::string           TypeName() const override { return GetTypeName<T>(); }
+    void                                Write(std::string& out) const override { Serializer<T>::Write(out, value); }
+    void                                WriteBinary(BinaryWriter& out) const override { BinarySerializer<T>::Write(out, value); }
+    [[nodiscard]] Box*                  Clone(std::pmr::memory_resource* target) const override { return New(target, value); }
+
+    // Maps and user types can write their members in any order, so what the Serializer wrote is put in order after
+    void WriteCanonical(std::string& out) const override
+    {
+        std::string json;
+        Serializer<T>::Write(json, value);
+        WriteCanonicalJson(out, json);
+    }
+
+    void Destroy() override
+    {
+        std::pmr::memory_resource* owner = resource;
+        this->~BoxOf();
+        owner->deallocate(this, sizeof(BoxOf), alignof(BoxOf));
+    }
+};
+
+} // namespace detail
+
+// A single json value in 16 bytes: a type tag next to either the scalar itself or a pointer to where the rest of it
+// lives. Strings, objects, arrays and uncommon types are allocated from the resource given when the value is assigned,
+// spans and string views are views over storage owned by someone else. Copies allocate from the default resource.
+//
+// Arrays are stored from a std::vector<T> and read back the same way as spans, through Get<std::span<T>>
+class JsonValue
+{
+public:
+    using Type = JsonType;
+
+    JsonValue() noexcept : mData{} {}
+
+    template<typename T>
+        requires detail::Storable<T>
+    JsonValue(T&& value, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : mData{}
+    {
+        Assign(std::forward<T>(value), resource);
+    }
+
+    JsonValue(const JsonValue& other) : mData{} { Assign(other, std::pmr::get_default_resource()); }
+
+    JsonValue(JsonValue&& other) noexcept :
+        mType(other.mType), mElement(other.mElement), mSize(other.mSize), mData(other.mData)
+    {
+        other.mType = Type::Null;
+    }
+
+    JsonValue& operator=(const JsonValue& other)
+    {
+        Assign(other, std::pmr::get_default_resource());
+        return *this;
+    }
+
+    JsonValue& operator=(JsonValue&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            mType       = other.mType;
+            mElement    = other.mElement;
+            mSize       = other.mSize;
+            mData       = other.mData;
+            other.mType = Type::Null;
+        }
+        return *this;
+    }
+
+    template<typename T>
+        requires detail::Storable<T>
+    JsonValue& operator=(T&& value)
+    {
+        Assign(std::forward<T>(value), std::pmr::get_default_resource());
+        return *this;
+    }
+
+    ~JsonValue() { Reset(); }
+
+    // Replaces the value, allocating whatever doesn't fit inline from resource. The new value is built before the
+    // old one is released, so assigning a value its own contents is fine
+    template<typename T>
+        requires detail::Storable<T>
+    void Assign(T&& value, std::pmr::memory_resource* resource);
+
+    void Assign(const JsonValue& value, std::pmr::memory_resource* resource);
+    void Assign(JsonValue&& value, std::pmr::memory_resource*) { *this = std::move(value); }
+
+    // Points the value at text instead of copying it, so text has to outlive the value. Copies of the value own their
+    // text. Read back with Get<std::string_view>
+    void AssignView(const std::string_view text)
+    {
+        if (text.size() > UINT32_MAX)
+        {
+            throw std::runtime_error("String is too large to view from a JsonValue");
+        }
+
+        Reset();
+        mType       = Type::StringView;
+        mSize       = static_cast<uint32_t>(text.size());
+        mData.chars = text.data();
+    }
+
+    // Releases whatever the value points at and makes it null
+    void Reset() noexcept;
+
+    [[nodiscard]] Type GetType() const { return mType; }
+    [[nodiscard]] bool IsNull() const { return mType == Type::Null; }
+
+    template<typename T>
+    [[nodiscard]] bool Holds() const
+    {
+        constexpr Type type = detail::TypeOf<T>;
+        if constexpr (type == Type::Span)
+        {
+            return (mType == Type::Span || mType == Type::Array) && mElement == detail::TypeOf<typename T::element_type>;
+        } else if constexpr (type == Type::Array)
+        {
+            return mType == Type::Array && mElement == detail::TypeOf<typename T::value_type>;
+        } else if constexpr (type == Type::StringView)
+        {
+            // Owned strings can be viewed too
+            return mType == Type::StringView || mType == Type::String;
+        } else if constexpr (type == Type::Boxed)
+        {
+            return mType == Type::Boxed && mData.box->TypeId() == typeid(T);
+        } else
+        {
+            return mType == type;
+        }
+    }
+
+    // A reference to the held T, or a std::span<E> or std::string_view by value for spans, arrays and string views.
+    // Throws std::runtime_error if the value holds something else, mentioning key when one is given
+    template<typename T>
+    [[nodiscard]] decltype(auto) Get(const std::string_view key = {}) const
+    {
+        static_assert(detail::TypeOf<T> != Type::Array, "Arrays are read back as spans, use Get<std::span<T>>");
+
+        if (!Holds<T>())
+        {
+            ThrowTypeMismatch(GetTypeName<T>(), key);
+        }
+
+        constexpr Type type = detail::TypeOf<T>;
+        if constexpr (type == Type::Null)
+        {
+            return nullptr;
+        } else if constexpr (type == Type::Bool)
+        {
+            return static_cast<const bool&>(mData.b);
+        } else if constexpr (type == Type::Int)
+        {
+            return static_cast<const int&>(mData.i);
+        } else if constexpr (type == Type::Float)
+        {
+            return static_cast<const float&>(mData.f);
+        } else if constexpr (type == Type::Double)
+        {
+            return static_cast<const double&>(mData.d);
+        } else if constexpr (type == Type::Char)
+        {
+            return static_cast<const char&>(mData.c);
+        } else if constexpr (type == Type::String)
+        {
+            return static_cast<const std::string&>(mData.string->value);
+        } else if constexpr (type == Type::StringView)
+        {
+            if (mType == Type::String)
+            {
+                return std::string_view(mData.string->value);
+            }
+            return std::string_view(mData.chars, mSize);
+        } else if constexpr (type == Type::Object)
+        {
+            return static_cast<const std::shared_ptr<JsonObject>&>(mData.object->value);
+        } else if constexpr (type == Type::InlineObject)
+        {
+            // Payload<T> rather than the member's type so nothing needs JsonObject to be complete before this is used
+            return static_cast<const T&>(static_cast<const detail::Payload<T>*>(mData.inlineObject)->value);
+        } else if constexpr (type == Type::Span)
+        {
+            using Element = typename T::element_type;
+            if (mType == Type::Array)
+            {
+                return std::span<Element>(detail::ArrayData(ArrayPayload<Element>()->value), mSize);
+            }
+            return std::span<Element>(static_cast<Element*>(const_cast<void*>(mData.span)), mSize);
+        } else
+        {
+            return static_cast<const T&>(static_cast<const detail::BoxOf<T>*>(mData.box)->value);
+        }
+    }
+
+    // The name of the held type, as GetTypeName would give it
+    [[nodiscard]] std::string TypeName() const;
+
+    [[noreturn]] void ThrowTypeMismatch(const std::string& expectedType, std::string_view key) const;
+
+    // Appends the value as json. Objects are written compactly, pretty printing is up to JsonObject::Write
+    void Write(std::string& out) const;
+
+    // Appends the value the way CanonicalOutput lays values out. Boxed values are written as their Serializer writes
+    // them, numbers at its precision, then given the same key order and number format
+    void WriteCanonical(std::string& out) const;
+
+    // Element count of a span or array, 0 for anything else
+    [[nodiscard]] size_t ElementCount() const { return mType == Type::Span || mType == Type::Array ? mSize : 0; }
+
+    // Type of the elements of a span or array, for detail::WithElementType
+    [[nodiscard]] Type ElementType() const { return mElement; }
+
+    // Appends elements [first, first + count) of a span or array as a json array of their own
+    void WriteElements(std::string& out, size_t first, size_t count) const;
+
+    // Appends the value as MessagePack or CBOR. Arrays of numbers are written packed
+    void WriteBinary(BinaryWriter& out) const;
+
+private:
+    template<typename E>
+    [[nodiscard]] detail::Payload<detail::ArrayStorage<E>>* ArrayPayload() const
+    {
+        return static_cast<detail::Payload<detail::ArrayStorage<E>>*>(mData.array);
+    }
+
+    [[nodiscard]] static uint32_t CheckedSize(const size_t size)
+    {
+        if (size > UINT32_MAX)
+        {
+            throw std::runtime_error("Array is too large to store in a JsonValue");
+        }
+        return static_cast<uint32_t>(size);
+    }
+
+    template<typename T>
+    void Set(const Type type, T* pointer)
+    {
+        Reset();
+        mType = type;
+        if constexpr (std::is_same_v<T, detail::Payload<std::string>>)
+        {
+            mData.string = pointer;
+        } else if constexpr (std::is_same_v<T, detail::Payload<std::shared_ptr<JsonObject>>>)
+        {
+            mData.object = pointer;
+        } else if constexpr (std::is_same_v<T, detail::Payload<JsonObject>>)
+        {
+            mData.inlineObject = pointer;
+        } else if constexpr (std::is_base_of_v<detail::Box, T>)
+        {
+            mData.box = pointer;
+        } else
+        {
+            mData.array = pointer;
+        }
+    }
+
+private:
+    Type     mType    = Type::Null;
+    Type     mElement = Type::Null; // Element type of a span or array
+    uint32_t mSize    = 0;          // Element count of a span or array, length of a string view
+
+    union Data
+    {
+        bool                                         b;
+        int                                          i;
+        float                                        f;
+        double                                       d;
+        char                                         c;
+        detail::Payload<std::string>*                string;
+        detail::Payload<std::shared_ptr<JsonObject>>* object;
+        detail::Payload<JsonObject>*                 inlineObject;
+        const void*                                  span;
+        const char*                                  chars; // StringView
+        void*                                        array; // Payload<ArrayStorage<E>>
+        detail::Box*                                 box;
+    } mData;
+};
+
+static_assert(sizeof(JsonValue) == 16, "JsonValue is meant to stay two words wide");
+
+template<typename T>
+    requires detail::Storable<T>
+void JsonValue::Assign(T&& value, std::pmr::memory_resource* resource)
+{
+    using U             = std::decay_t<T>;
+    constexpr Type type = detail::StoredTypeOf<U>;
+
+    if constexpr (type == Type::String)
+    {
+        if constexpr (std::is_same_v<U, std::string>)
+        {
+            Set(type, detail::NewPayload<std::string>(resource, std::forward<T>(value)));
+        } else
+        {
+            Set(type, detail::NewPayload<std::string>(resource, std::string_view(value)));
+        }
+    } else if constexpr (type == Type::Object)
+    {
+        Set(type, detail::NewPayload<std::shared_ptr<JsonObject>>(resource, std::forward<T>(value)));
+    } else if constexpr (type == Type::InlineObject)
+    {
+        Set(type, detail::NewPayload<JsonObject>(resource, std::forward<T>(value)));
+    } else if constexpr (type == Type::Array)
+    {
+        using Element       = typename U::value_type;
+        const uint32_t size = CheckedSize(value.size());
+
+        if constexpr (std::is_same_v<Element, bool>)
+        {
+            auto buffer = std::make_unique<bool[]>(size);
+            std::copy(value.begin(), value.end(), buffer.get());
+            Set(type, detail::NewPayload<detail::ArrayStorage<bool>>(resource, std::move(buffer)));
+        } else
+        {
+            Set(type, detail::NewPayload<std::vector<Element>>(resource, std::forward<T>(value)));
+        }
+        mElement = detail::TypeOf<Element>;
+        mSize    = size;
+    } else if constexpr (type == Type::Boxed)
+    {
+        Set(type, detail::BoxOf<U>::New(resource, std::forward<T>(value)));
+    } else
+    {
+        if constexpr (type == Type::Span)
+        {
+            static_cast<void>(CheckedSize(value.size())); // before Reset, so a throw leaves the old value alone
+        }
+
+        Reset();
+        mType = type;
+        if constexpr (type == Type::Bool)
+        {
+            mData.b = value;
+        } else if constexpr (type == Type::Int)
+        {
+            mData.i = value;
+        } else if constexpr (type == Type::Float)
+        {
+            mData.f = value;
+        } else if constexpr (type == Type::Double)
+        {
+            mData.d = value;
+        } else if constexpr (type == Type::Char)
+        {
+            mData.c = value;
+        } else if constexpr (type == Type::Span)
+        {
+            mElement   = detail::TypeOf<typename U::element_type>;
+            mSize      = static_cast<uint32_t>(value.size());
+            mData.span = value.data();
+        }
+    }
+}
+
+template<>
+struct Serializer<JsonValue>
+{
+    static void Write(std::string& out, const JsonValue& value) { value.Write(out); }
+
+    static std::string Serialize(const JsonValue& value)
+    {
+        std::string out;
+        value.Write(out);
+        return out;
+    }
+};
+
+template<>
+struct BinarySerializer<JsonValue>
+{
+    static void Write(BinaryWriter& out, const JsonValue& value) { value.WriteBinary(out); }
+};
+
+} // namespace cereal
@@ -0,0 +1,331 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: ValueMap.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Symbol.h"
+#include "Value.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cereal
+{
+
+// The members of a JsonObject, kept contiguous and in insertion order so documents serialize in the order they were
+// built or read. Small objects are searched with a straight scan over the keys, which beats hashing for the handful
+// of members most objects have. Past IndexThreshold members an open addressing index of member positions is built
+// and kept up to date from then on.
+//
+// Adding a member may move the others, so references to values are only stable until the next insertion
+class ValueMap
+{
+public:
+    // A member's name. Keys are copied into memory from the map's resource, unless they were added with
+    // try_emplace_view, in which case they point at characters owned by someone else, or with a Symbol, in which case
+    // they point at the symbol's text
+    class Key
+    {
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+        Key(const std::string_view text, const allocator_type& allocator = {}) : mResource(allocator.resource())
+        {
+            Copy(text);
+        }
+
+        Key(const Key& other, const allocator_type& allocator = {}) : mResource(allocator.resource())
+        {
+            if (other.mStorage != Storage::Owned)
+            {
+                Borrow(other);
+            } else
+            {
+                Copy(other);
+            }
+        }
+
+        Key(Key&& other) noexcept : mResource(other.mResource) { Steal(other); }
+
+        Key(Key&& other, const allocator_type& allocator) : mResource(allocator.resource())
+        {
+            if (other.mStorage != Storage::Owned || *other.mResource == *mResource)
+            {
+                Steal(other);
+            } else
+            {
+                Copy(other);
+            }
+        }
+
+        Key& operator=(const Key& other)
+        {
+            if (this != &other)
+            {
+                Key copy(other, allocator_type(mResource));
+                Release();
+                Steal(copy);
+            }
+            return *this;
+        }
+
+        Key& operator=(Key&& other)
+        {
+            if (this != &other)
+            {
+                Key moved(std::move(other), allocator_type(mResource));
+                Release();
+                Steal(moved);
+            }
+            return *this;
+        }
+
+        ~Key() { Release(); }
+
+        // A key that refers to text instead of copying it
+        [[nodiscard]] static Key View(const std::string_view text)
+        {
+            Key key(std::string_view(), allocator_type{});
+            key.mData    = text.data();
+            key.mSize    = CheckedSize(text.size());
+            key.mStorage = Storage::Borrowed;
+            return key;
+        }
+
+        // A key that refers to the symbol's text
+        [[nodiscard]] static Key Interned(const Symbol& symbol)
+        {
+            Key key(std::string_view(), allocator_type{});
+            key.mData    = symbol.Text().data();
+            key.mSize    = static_cast<uint32_t>(symbol.Text().size());
+            key.mStorage = Storage::Interned;
+            return key;
+        }
+
+        // The symbol this key was added with, or nullptr if it wasn't added with one
+        [[nodiscard]] const Symbol* GetSymbol() const
+        {
+            return mStorage == Storage::Interned ? &Symbol::FromText(mData) : nullptr;
+        }
+
+        [[nodiscard]] uint64_t Hash() const
+        {
+            return mStorage == Storage::Interned ? Symbol::FromText(mData).Hash() : detail::HashKey(*this);
+        }
+
+        operator std::string_view() const { return { mData, mSize }; }
+
+        [[nodiscard]] const char* data() const { return mData; }
+        [[nodiscard]] size_t      size() const { return mSize; }
+        [[nodiscard]] bool        empty() const { return mSize == 0; }
+        [[nodiscard]] char        back() const { return mData[mSize - 1]; }
+
+        friend bool operator==(const Key& key, const std::string_view text) { return std::string_view(key) == text; }
+
+    private:
+        [[nodiscard]] static uint32_t CheckedSize(const size_t size)
+        {
+            if (size > UINT32_MAX)
+            {
+                throw std::runtime_error("Key is too long to store in a JsonObject");
+            }
+            return static_cast<uint32_t>(size);
+        }
+
+        void Copy(const std::string_view text)
+        {
+            mSize = CheckedSize(text.size());
+            if (mSize > 0)
+            {
+                char* copy = static_cast<char*>(mResource->allocate(mSize, 1));
+                CEREAL_INSTRUMENT_ALLOCATION(mSize);
+                std::memcpy(copy, text.data(), mSize);
+                mData = copy;
+            }
+        }
+
+        void Borrow(const Key& other)
+        {
+            mData    = other.mData;
+            mSize    = other.mSize;
+            mStorage = other.mStorage;
+        }
+
+        void Steal(Key& other) noexcept
+        {
+            mData          = other.mData;
+            mSize          = other.mSize;
+            mStorage       = other.mStorage;
+            mResource      = other.mResource;
+            other.mData    = nullptr;
+            other.mSize    = 0;
+            other.mStorage = Storage::Owned;
+        }
+
+        void Release() noexcept
+        {
+            if (mStorage == Storage::Owned && mSize > 0)
+            {
+                mResource->deallocate(const_cast<char*>(mData), mSize, 1);
+            }
+            mData = nullptr;
+            mSize = 0;
+        }
+
+    private:
+        enum class Storage : uint8_t
+        {
+            Owned,
+            Borrowed,
+            Interned
+        };
+
+        const char*                mData    = nullptr;
+        uint32_t                   mSize    = 0;
+        Storage                    mStorage = Storage::Owned;
+        std::pmr::memory_resource* mResource;
+    };
+
+    using key_type        = Key;
+    using mapped_type     = JsonValue;
+    using value_type      = std::pair<Key, JsonValue>;
+    using allocator_type  = std::pmr::polymorphic_allocator<value_type>;
+    using iterator        = std::pmr::vector<value_type>::iterator;
+    using const_iterator  = std::pmr::vector<value_type>::const_iterator;
+    using size_type       = size_t;
+
+    static constexpr size_t IndexThreshold = 16;
+
+    ValueMap() = default;
+    explicit ValueMap(const allocator_type& allocator) : mMembers(allocator), mIndex(allocator) {}
+
+    [[nodiscard]] allocator_type get_allocator() const { return mMembers.get_allocator(); }
+
+    [[nodiscard]] iterator       begin() { return mMembers.begin(); }
+    [[nodiscard]] iterator       end() { return mMembers.end(); }
+    [[nodiscard]] const_iterator begin() const { return mMembers.begin(); }
+    [[nodiscard]] const_iterator end() const { return mMembers.end(); }
+
+    [[nodiscard]] size_t size() const { return mMembers.size(); }
+    [[nodiscard]] bool   empty() const { return mMembers.empty(); }
+
+    [[nodiscard]] iterator       find(const std::string_view key) { return mMembers.begin() + IndexOf(key); }
+    [[nodiscard]] const_iterator find(const std::string_view key) const { return mMembers.begin() + IndexOf(key); }
+    [[nodiscard]] bool           contains(const std::string_view key) const { return IndexOf(key) != mMembers.size(); }
+
+    // A hashed key's hash is used as is instead of being worked out again
+    [[nodiscard]] iterator       find(const HashedKey& key) { return mMembers.begin() + IndexOf(key); }
+    [[nodiscard]] const_iterator find(const HashedKey& key) const { return mMembers.begin() + IndexOf(key); }
+    [[nodiscard]] bool           contains(const HashedKey& key) const { return IndexOf(key) != mMembers.size(); }
+
+    // Members added with the same symbol are found by comparing addresses, and the symbol's hash is used as is
+    [[nodiscard]] iterator       find(const Symbol& key) { return mMembers.begin() + IndexOf(key); }
+    [[nodiscard]] const_iterator find(const Symbol& key) const { return mMembers.begin() + IndexOf(key); }
+    [[nodiscard]] bool           contains(const Symbol& key) const { return IndexOf(key) != mMembers.size(); }
+
+    // Appends a null member under key unless there already is one. The bool is true if the member is new
+    std::pair<iterator, bool> try_emplace(std::string_view key) { return Emplace(key, false); }
+
+    // The same, but a new member's key points at key's characters instead of copying them, so they have to outlive
+    // the map and every copy of it
+    std::pair<iterator, bool> try_emplace_view(std::string_view key) { return Emplace(key, true); }
+
+    std::pair<iterator, bool> try_emplace(const HashedKey& key);
+
+    // The same, but a new member's key is the symbol, which costs no allocation
+    std::pair<iterator, bool> try_emplace(const Symbol& key);
+
+    void reserve(size_t count) { mMembers.reserve(count); }
+
+    void clear()
+    {
+        mMembers.clear();
+        mIndex.clear();
+    }
+
+private:
+    // Position of key in mMembers, or mMembers.size() if it isn't there
+    [[nodiscard]] size_t IndexOf(const std::string_view key) const
+    {
+        if (mIndex.empty())
+        {
+            // Keys like "item_1", "item_2" share everything but the end, so look there before comparing the lot
+            for (size_t i = 0; i < mMembers.size(); ++i)
+            {
+                const Key& candidate = mMembers[i].first;
+                if (candidate.size() == key.size() && (key.empty() || candidate.back() == key.back()) && candidate == key)
+                {
+                    return i;
+                }
+            }
+            return mMembers.size();
+        }
+        return Lookup(key, detail::HashKey(key), nullptr);
+    }
+
+    [[nodiscard]] size_t IndexOf(const HashedKey& key) const
+    {
+        return mIndex.empty() ? IndexOf(key.Text()) : Lookup(key.Text(), key.Hash(), nullptr);
+    }
+
+    [[nodiscard]] size_t IndexOf(const Symbol& key) const
+    {
+        if (mIndex.empty())
+        {
+            // Only keys that weren't added with a symbol need their characters compared
+            const std::string_view text = key.Text();
+            for (size_t i = 0; i < mMembers.size(); ++i)
+            {
+                const Key& candidate = mMembers[i].first;
+                if (candidate.data() == text.data() || (!candidate.GetSymbol() && candidate == text))
+                {
+                    return i;
+                }
+            }
+            return mMembers.size();
+        }
+        return Lookup(key.Text(), key.Hash(), &key);
+    }
+
+    std::pair<iterator, bool> Emplace(std::string_view key, bool view);
+    std::pair<iterator, bool> Append(Key&& key);
+
+    [[nodiscard]] size_t Lookup(std::string_view key, uint64_t hash, const Symbol* symbol) const;
+    void                 Insert(size_t position, uint64_t hash);
+    void                 Rebuild(size_t capacity);
+
+private:
+    std::pmr::vector<value_type> mMembers;
+
+    // Empty until the object outgrows IndexThreshold. Each slot holds the upper half of the key's hash and one past
+    // the member's position, zero marks a free slot. Never more than half full
+    std::pmr::vector<uint64_t> mIndex;
+};
+
+} // namespace cereal
@@ -0,0 +1,185 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Writer.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Instrument.h"
+#include "Serializer.h"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <ostream>
+
+namespace cereal
+{
+
+// Layouts JsonObject can be written in. Each one is an instantiation of its own, so compact output never tests for
+// pretty printing and neither of them tests for canonical ordering
+struct CompactOutput
+{
+    static constexpr bool Pretty    = false;
+    static constexpr bool Canonical = false;
+};
+
+struct PrettyOutput
+{
+    static constexpr bool Pretty    = true;
+    static constexpr bool Canonical = false;
+};
+
+// Byte stable output to hash, cache by content or diff: keys sorted by their utf-8 bytes, no whitespace, and numbers
+// at the shortest precision that reads back exactly, whatever CEREAL_FLT_PRECISION and CEREAL_DBL_PRECISION are
+struct CanonicalOutput
+{
+    static constexpr bool Pretty    = false;
+    static constexpr bool Canonical = true;
+};
+
+namespace detail
+{
+
+// A line break followed by enough spaces for most indentation, so indenting is a single append
+inline constexpr auto NewLineAndSpaces = [] {
+    std::array<char, 257> text{};
+    text.fill(' ');
+    text[0] = '\n';
+    return text;
+}();
+
+} // namespace detail
+
+// Appends an entire document into a single growable buffer. The buffer is either owned by the caller, in which case it
+// simply grows until the document is done, or it belongs to the writer and gets flushed to an output stream whenever it
+// crosses the flush threshold so memory stays bounded no matter how large the document is
+class JsonWriter
+{
+public:
+    static constexpr size_t DefaultFlushThreshold = 64 * 1024;
+
+    explicit JsonWriter(std::string& buffer) : mBuffer(buffer) {}
+
+    explicit JsonWriter(std::ostream& sink, size_t flushThreshold = DefaultFlushThreshold) :
+        mBuffer(mOwnedBuffer), mSink(&sink), mFlushThreshold(flushThreshold)
+    {
+        mOwnedBuffer.reserve(flushThreshold + flushThreshold / 4);
+    }
+
+    ~JsonWriter() { Flush(); }
+
+    JsonWriter(const JsonWriter&)            = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    [[nodiscard]] std::string& Buffer() { return mBuffer; }
+
+    void Append(const std::string_view text)
+    {
+        CEREAL_INSTRUMENT_GROWTH(mBuffer);
+        mBuffer += text;
+    }
+
+    void Append(const char c)
+    {
+        CEREAL_INSTRUMENT_GROWTH(mBuffer);
+        mBuffer += c;
+    }
+
+    void AppendIndent(const size_t count)
+    {
+        CEREAL_INSTRUMENT_GROWTH(mBuffer);
+        AppendSpaces(count);
+    }
+
+    // A line break followed by count spaces
+    void AppendNewLine(const size_t count)
+    {
+        CEREAL_INSTRUMENT_GROWTH(mBuffer);
+        if (count < detail::NewLineAndSpaces.size())
+        {
+            mBuffer.append(detail::NewLineAndSpaces.data(), count + 1);
+            return;
+        }
+        mBuffer += '\n';
+        AppendSpaces(count);
+    }
+
+    void AppendString(const std::string_view text)
+    {
+        CEREAL_INSTRUMENT_GROWTH(mBuffer);
+        WriteEscapedString(mBuffer, text);
+    }
+
+    template<typename T>
+    void AppendValue(const T& value)
+    {
+        CEREAL_INSTRUMENT_GROWTH(mBuffer);
+        Serializer<T>::Write(mBuffer, value);
+    }
+
+    // Writes value the way CanonicalOutput lays values out
+    template<typename T>
+    void AppendCanonical(const T& value)
+    {
+        CEREAL_INSTRUMENT_GROWTH(mBuffer);
+        value.WriteCanonical(mBuffer);
+    }
+
+    // Hands everything written so far to the sink. Does nothing when writing into a caller owned buffer
+    void Flush()
+    {
+        if (mSink && !mBuffer.empty())
+        {
+            CEREAL_INSTRUMENT_PHASE(Phase::Io);
+            CEREAL_INSTRUMENT_BYTES(mBuffer.size());
+            mSink->write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+            mBuffer.clear();
+        }
+    }
+
+    void MaybeFlush()
+    {
+        if (mSink && mBuffer.size() >= mFlushThreshold)
+        {
+            Flush();
+        }
+    }
+
+private:
+    void AppendSpaces(size_t count)
+    {
+        constexpr size_t available = detail::NewLineAndSpaces.size() - 1;
+        for (; count > available; count -= available)
+        {
+            mBuffer.append(detail::NewLineAndSpaces.data() + 1, available);
+        }
+        mBuffer.append(detail::NewLineAndSpaces.data() + 1, count);
+    }
+
+private:
+    std::string   mOwnedBuffer;
+    std::string&  mBuffer;
+    std::ostream* mSink           = nullptr;
+    size_t        mFlushThreshold = 0;
+};
+
+} // namespace cereal
@@ -24,6 +24,5 @@ project "cereal"
     links {
         
     }
-    defines {
-        "CEREAL_DBL_PRECISION=5"
-    }
\ No newline at end of file
+
+    platform_defines()
\ No newline at end of file
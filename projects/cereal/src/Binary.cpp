@@ -0,0 +1,653 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Binary
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "Binary.h"
+#include "Json.h"
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace cereal
+{
+
+namespace
+{
+
+using Event = BinaryReader::Event;
+
+// What a typed array tag says about its elements. RFC 8746 packs it into the low bits of the tag: whether the
+// elements are floating point, whether they are signed, whether they are little endian and their size
+struct PackedElement
+{
+    size_t size         = 0; // 0 for tags that aren't typed arrays, or ones we don't read
+    bool   floating     = false;
+    bool   isSigned     = false;
+    bool   littleEndian = false;
+};
+
+PackedElement DescribeTag(const uint64_t tag)
+{
+    if (tag < 64 || tag > 87)
+    {
+        return {};
+    }
+
+    const auto    bits = static_cast<uint8_t>(tag - 64);
+    PackedElement element{ 0, (bits & 0x10) != 0, (bits & 0x08) != 0, (bits & 0x04) != 0 };
+    if (element.floating)
+    {
+        // float16, float32 and float64. float128 isn't supported
+        element.size = (bits & 0x03) == 3 ? 0 : size_t{ 2 } << (bits & 0x03);
+    } else
+    {
+        element.size = size_t{ 1 } << (bits & 0x03);
+        if (element.size == 1)
+        {
+            // The little endian bit on single bytes means a clamped uint8, which reads the same as uint8. There is
+            // no signed version of it
+            element.size         = element.isSigned && element.littleEndian ? 0 : 1;
+            element.littleEndian = false;
+        }
+    }
+    return element;
+}
+
+double HalfToDouble(const uint16_t half)
+{
+    const int exponent = (half >> 10) & 0x1f;
+    const int mantissa = half & 0x3ff;
+
+    double value = 0.0;
+    if (exponent == 0)
+    {
+        value = std::ldexp(mantissa, -24);
+    } else if (exponent != 31)
+    {
+        value = std::ldexp(mantissa + 1024, exponent - 25);
+    } else
+    {
+        value = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+    }
+    return (half & 0x8000) ? -value : value;
+}
+
+} // namespace
+
+BinaryReader::BinaryReader(const std::string_view bytes, const BinaryFormat format) : mBytes(bytes), mFormat(format) {}
+
+void BinaryReader::Error(const std::string_view message) const
+{
+    throw std::runtime_error(std::string(mFormat == BinaryFormat::Cbor ? "CBOR" : "MessagePack") + " parse error at offset " +
+                             std::to_string(mPos) + ": " + std::string(message));
+}
+
+BinaryReader::Event BinaryReader::Next()
+{
+    if (mStack.empty())
+    {
+        if (mDone)
+        {
+            if (mPos != mBytes.size())
+            {
+                Error("unexpected data after the document");
+            }
+            return mLast = Event::EndOfDocument;
+        }
+
+        const Event event = ReadValue();
+        mDone             = mStack.empty();
+        return event;
+    }
+
+    Frame& frame = mStack.back();
+    if (frame.kind == Kind::Map && frame.value)
+    {
+        frame.value = false;
+        return ReadValue();
+    }
+
+    // Indefinite containers end at a break byte, everything else when its count runs out
+    if (frame.indefinite ? (Need(1), static_cast<uint8_t>(mBytes[mPos]) == 0xff) : frame.remaining == 0)
+    {
+        mPos += frame.indefinite ? 1 : 0;
+        const Kind kind = frame.kind;
+        mStack.pop_back();
+        mDone = mStack.empty();
+        return mLast = kind == Kind::Map ? Event::EndObject : Event::EndArray;
+    }
+
+    if (!frame.indefinite)
+    {
+        --frame.remaining;
+    }
+
+    if (frame.kind == Kind::Packed)
+    {
+        return ReadPackedElement(frame);
+    }
+    if (frame.kind == Kind::Map)
+    {
+        frame.value = true;
+        if (ReadValue() != Event::String)
+        {
+            Error("object keys must be strings");
+        }
+        return mLast = Event::Key;
+    }
+    return ReadValue();
+}
+
+void BinaryReader::SkipValue()
+{
+    size_t depth = 0;
+    if (mLast == Event::StartObject || mLast == Event::StartArray)
+    {
+        depth = mStack.size() - 1;
+    } else if (mLast == Event::Key)
+    {
+        depth = mStack.size();
+        Next();
+    } else
+    {
+        return;
+    }
+
+    while (mStack.size() > depth)
+    {
+        // Packed arrays are skipped in one step rather than element by element
+        if (Frame& frame = mStack.back(); frame.kind == Kind::Packed)
+        {
+            mPos += frame.remaining * DescribeTag(frame.tag).size;
+            frame.remaining = 0;
+        }
+        Next();
+    }
+}
+
+bool BinaryReader::TakePackedBytes(const uint8_t tag, const uint8_t swappedTag, const size_t size, const char*& data,
+                                   size_t& count, bool& swapped)
+{
+    if (mLast != Event::StartArray || mStack.back().kind != Kind::Packed)
+    {
+        return false;
+    }
+
+    const Frame& frame = mStack.back();
+    if (frame.tag != tag && frame.tag != swappedTag)
+    {
+        return false;
+    }
+
+    data    = mBytes.data() + mPos;
+    count   = frame.remaining;
+    swapped = frame.tag != tag;
+    mPos += count * size;
+
+    mStack.pop_back();
+    mDone = mStack.empty();
+    mLast = Event::EndArray;
+    return true;
+}
+
+BinaryReader::Event BinaryReader::ReadValue()
+{
+    return mFormat == BinaryFormat::Cbor ? ReadCbor() : ReadMessagePack();
+}
+
+BinaryReader::Event BinaryReader::ReadMessagePack()
+{
+    const uint8_t byte = Byte();
+
+    // Fixed size forms that keep their value or length in the marker byte itself
+    if (byte <= 0x7f)
+    {
+        return Unsigned(byte);
+    }
+    if (byte >= 0xe0)
+    {
+        return Signed(static_cast<int8_t>(byte));
+    }
+    if (byte <= 0x8f)
+    {
+        return Start(Kind::Map, byte & 0x0f);
+    }
+    if (byte <= 0x9f)
+    {
+        return Start(Kind::Array, byte & 0x0f);
+    }
+    if (byte <= 0xbf)
+    {
+        return String(byte & 0x1f);
+    }
+
+    // Packed arrays are the only ext types we write or read
+    const auto ext = [this](const uint64_t size) {
+        const uint8_t type = Byte();
+        if (DescribeTag(type).size == 0)
+        {
+            Error("unsupported ext type " + std::to_string(static_cast<int8_t>(type)));
+        }
+        return StartPacked(type, size);
+    };
+
+    switch (byte)
+    {
+    case 0xc0: return mLast = Event::Null;
+    case 0xc2:
+    case 0xc3: mBool = byte == 0xc3; return mLast = Event::Bool;
+    case 0xc7:
+    case 0xc8:
+    case 0xc9: return ext(BigEndian(size_t{ 1 } << (byte - 0xc7)));
+    case 0xca: return Float(std::bit_cast<float>(static_cast<uint32_t>(BigEndian(4))));
+    case 0xcb: return Float(std::bit_cast<double>(BigEndian(8)));
+    case 0xcc:
+    case 0xcd:
+    case 0xce:
+    case 0xcf: return Unsigned(BigEndian(size_t{ 1 } << (byte - 0xcc)));
+    case 0xd0: return Signed(static_cast<int8_t>(BigEndian(1)));
+    case 0xd1: return Signed(static_cast<int16_t>(BigEndian(2)));
+    case 0xd2: return Signed(static_cast<int32_t>(BigEndian(4)));
+    case 0xd3: return Signed(static_cast<int64_t>(BigEndian(8)));
+    case 0xd4:
+    case 0xd5:
+    case 0xd6:
+    case 0xd7:
+    case 0xd8: return ext(uint64_t{ 1 } << (byte - 0xd4));
+    case 0xd9:
+    case 0xda:
+    case 0xdb: return String(BigEndian(size_t{ 1 } << (byte - 0xd9)));
+    case 0xdc: return Start(Kind::Array, BigEndian(2));
+    case 0xdd: return Start(Kind::Array, BigEndian(4));
+    case 0xde: return Start(Kind::Map, BigEndian(2));
+    case 0xdf: return Start(Kind::Map, BigEndian(4));
+    case 0xc4:
+    case 0xc5:
+    case 0xc6: Error("byte strings are not supported");
+    default: Error("invalid marker byte");
+    }
+}
+
+BinaryReader::Event BinaryReader::ReadCbor()
+{
+    for (;;)
+    {
+        const uint8_t byte  = Byte();
+        const uint8_t major = byte >> 5;
+        const uint8_t info  = byte & 0x1f;
+
+        if (major == 7)
+        {
+            switch (info)
+            {
+            case 20:
+            case 21: mBool = info == 21; return mLast = Event::Bool;
+            case 22:
+            case 23: return mLast = Event::Null; // null and undefined
+            case 25: return Float(HalfToDouble(static_cast<uint16_t>(BigEndian(2))));
+            case 26: return Float(std::bit_cast<float>(static_cast<uint32_t>(BigEndian(4))));
+            case 27: return Float(std::bit_cast<double>(BigEndian(8)));
+            case 31: Error("unexpected break");
+            default: Error("unsupported simple value");
+            }
+        }
+
+        if (info == 31)
+        {
+            switch (major)
+            {
+            case 4: return Start(Kind::Array, 0, true);
+            case 5: return Start(Kind::Map, 0, true);
+            default: Error("indefinite length strings are not supported");
+            }
+        }
+
+        uint64_t argument = info;
+        if (info >= 24 && info <= 27)
+        {
+            argument = BigEndian(size_t{ 1 } << (info - 24));
+        } else if (info > 27)
+        {
+            Error("invalid additional information");
+        }
+
+        switch (major)
+        {
+        case 0: return Unsigned(argument);
+        case 1:
+            // -1 - argument
+            if (argument > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+            {
+                Error("integer is too large");
+            }
+            return Signed(-1 - static_cast<int64_t>(argument));
+        case 2: Error("byte strings are not supported");
+        case 3: return String(argument);
+        case 4: return Start(Kind::Array, argument);
+        case 5: return Start(Kind::Map, argument);
+        default:
+            // Tags other than typed arrays are ignored and the value they tag is read as it is
+            if (DescribeTag(argument).size != 0)
+            {
+                const uint8_t header = Byte();
+                const uint8_t length = header & 0x1f;
+                if (header >> 5 != 2 || length > 27)
+                {
+                    Error("typed arrays have to hold a definite length byte string");
+                }
+                return StartPacked(static_cast<uint8_t>(argument),
+                                   length < 24 ? length : BigEndian(size_t{ 1 } << (length - 24)));
+            }
+            break;
+        }
+    }
+}
+
+BinaryReader::Event BinaryReader::ReadPackedElement(const Frame& frame)
+{
+    const PackedElement element = DescribeTag(frame.tag);
+
+    Need(element.size);
+    uint64_t bits = 0;
+    for (size_t i = 0; i < element.size; ++i)
+    {
+        const size_t shift = element.littleEndian ? i : element.size - 1 - i;
+        bits |= uint64_t{ static_cast<uint8_t>(mBytes[mPos + i]) } << (shift * 8);
+    }
+    mPos += element.size;
+
+    if (element.floating)
+    {
+        switch (element.size)
+        {
+        case 2: return Float(HalfToDouble(static_cast<uint16_t>(bits)));
+        case 4: return Float(std::bit_cast<float>(static_cast<uint32_t>(bits)));
+        default: return Float(std::bit_cast<double>(bits));
+        }
+    }
+
+    if (element.isSigned && element.size < 8)
+    {
+        // Sign extend
+        const uint64_t sign = uint64_t{ 1 } << (element.size * 8 - 1);
+        return Signed(static_cast<int64_t>((bits ^ sign) - sign));
+    }
+    return element.isSigned ? Signed(static_cast<int64_t>(bits)) : Unsigned(bits);
+}
+
+BinaryReader::Event BinaryReader::Start(const Kind kind, const uint64_t count, const bool indefinite)
+{
+    if (mStack.size() >= MaxDepth)
+    {
+        Error("document is nested too deeply");
+    }
+
+    mStack.push_back({ count, kind, indefinite });
+    return mLast = kind == Kind::Map ? Event::StartObject : Event::StartArray;
+}
+
+BinaryReader::Event BinaryReader::StartPacked(const uint8_t tag, const uint64_t size)
+{
+    const PackedElement element = DescribeTag(tag);
+    if (element.size == 0)
+    {
+        Error("unsupported typed array");
+    }
+    if (size % element.size != 0)
+    {
+        Error("typed array length is not a multiple of its element size");
+    }
+    Need(size);
+
+    Start(Kind::Array, size / element.size);
+    mStack.back().kind = Kind::Packed;
+    mStack.back().tag  = tag;
+    return mLast;
+}
+
+BinaryReader::Event BinaryReader::String(const uint64_t length)
+{
+    Need(length);
+    mString = mBytes.substr(mPos, length);
+    mPos += length;
+    return mLast = Event::String;
+}
+
+BinaryReader::Event BinaryReader::Unsigned(const uint64_t value)
+{
+    if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+    {
+        Error("integer is too large");
+    }
+    return Signed(static_cast<int64_t>(value));
+}
+
+BinaryReader::Event BinaryReader::Signed(const int64_t value)
+{
+    mInteger = value;
+    return mLast = Event::Integer;
+}
+
+BinaryReader::Event BinaryReader::Float(const double value)
+{
+    mDouble = value;
+    return mLast = Event::Double;
+}
+
+uint8_t BinaryReader::Byte()
+{
+    Need(1);
+    return static_cast<uint8_t>(mBytes[mPos++]);
+}
+
+uint64_t BinaryReader::BigEndian(const size_t size)
+{
+    Need(size);
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        value = value << 8 | static_cast<uint8_t>(mBytes[mPos++]);
+    }
+    return value;
+}
+
+void BinaryReader::Need(const uint64_t size) const
+{
+    if (size > mBytes.size() - mPos)
+    {
+        Error("unexpected end of document");
+    }
+}
+
+namespace
+{
+
+void ReadMembers(BinaryReader& reader, JsonObject& object);
+
+// Adds the numbers collected from an array the same way Parse does: as int if every one of them is an integer that
+// fits, otherwise as double
+void AddNumbers(JsonObject& object, const std::string_view key, std::vector<double>&& numbers, const bool allInt)
+{
+    if (allInt)
+    {
+        object.Add(key, std::vector<int>(numbers.begin(), numbers.end()));
+    } else
+    {
+        object.Add(key, std::move(numbers));
+    }
+}
+
+// Collects the elements of an array that has to hold a single type, starting with the element whose event was just
+// read. read(event) returns false for elements of the wrong type
+template<typename T, typename Fn>
+std::vector<T> ReadElements(BinaryReader& reader, Event event, Fn&& read)
+{
+    std::vector<T> values;
+    for (; event != Event::EndArray; event = reader.Next())
+    {
+        if (!read(event, values))
+        {
+            reader.Error("arrays mixing different types are not supported by JsonObject");
+        }
+    }
+    return values;
+}
+
+void ReadArray(BinaryReader& reader, JsonObject& object, const std::string_view key)
+{
+    // Packed arrays of the types JsonObject stores go straight into the array
+    if (std::vector<int> ints; reader.TakePacked(ints))
+    {
+        object.Add(key, std::move(ints));
+        return;
+    }
+    if (std::vector<double> doubles; reader.TakePacked(doubles))
+    {
+        object.Add(key, std::move(doubles));
+        return;
+    }
+    if (std::vector<float> floats; reader.TakePacked(floats))
+    {
+        object.Add(key, std::move(floats));
+        return;
+    }
+
+    const Event first = reader.Next();
+    switch (first)
+    {
+    case Event::EndArray: object.Add(key, std::span<int>()); return;
+    case Event::StartArray: reader.Error("nested arrays are not supported by JsonObject");
+    case Event::Null: reader.Error("null inside arrays is not supported by JsonObject");
+    case Event::String:
+        object.Add(key, ReadElements<std::string>(reader, first, [&reader](const Event event, auto& values) {
+                       values.emplace_back(reader.GetString());
+                       return event == Event::String;
+                   }));
+        return;
+    case Event::Bool:
+        object.Add(key, ReadElements<bool>(reader, first, [&reader](const Event event, auto& values) {
+                       values.push_back(reader.GetBool());
+                       return event == Event::Bool;
+                   }));
+        return;
+    case Event::StartObject:
+        object.Add(key, ReadElements<std::shared_ptr<JsonObject>>(reader, first, [&](const Event event, auto& values) {
+                       if (event != Event::StartObject)
+                       {
+                           return false;
+                       }
+                       auto child = object.CreateObject();
+                       ReadMembers(reader, *child);
+                       values.push_back(std::move(child));
+                       return true;
+                   }));
+        return;
+    default: break;
+    }
+
+    bool allInt  = true;
+    auto numbers = ReadElements<double>(reader, first, [&reader, &allInt](const Event event, auto& values) {
+        if (event == Event::Integer)
+        {
+            allInt &= std::in_range<int>(reader.GetInteger());
+            values.push_back(static_cast<double>(reader.GetInteger()));
+            return true;
+        }
+        allInt = false;
+        values.push_back(reader.GetDouble());
+        return event == Event::Double;
+    });
+    AddNumbers(object, key, std::move(numbers), allInt);
+}
+
+void ReadMembers(BinaryReader& reader, JsonObject& object)
+{
+    for (Event event = reader.Next(); event != Event::EndObject; event = reader.Next())
+    {
+        // Keys point into the input, so they stay valid while the value is read
+        const std::string_view key = reader.GetString();
+        switch (reader.Next())
+        {
+        case Event::StartObject:
+        {
+            auto child = object.CreateObject();
+            ReadMembers(reader, *child);
+            object.Add(key, std::move(child));
+            break;
+        }
+        case Event::StartArray: ReadArray(reader, object, key); break;
+        case Event::String: object.Add(key, reader.GetString()); break;
+        case Event::Integer:
+            if (std::in_range<int>(reader.GetInteger()))
+            {
+                object.Add(key, static_cast<int>(reader.GetInteger()));
+            } else
+            {
+                object.Add(key, static_cast<double>(reader.GetInteger()));
+            }
+            break;
+        case Event::Double: object.Add(key, reader.GetDouble()); break;
+        case Event::Bool: object.Add(key, reader.GetBool()); break;
+        default: object.Add(key, nullptr); break;
+        }
+    }
+}
+
+} // namespace
+
+JsonObject JsonObject::FromBinary(const std::string_view bytes, const BinaryFormat format, std::pmr::memory_resource* resource)
+{
+    BinaryReader reader(bytes, format);
+    if (reader.Next() != Event::StartObject)
+    {
+        reader.Error("the document root has to be a map");
+    }
+
+    JsonObject root(resource);
+    ReadMembers(reader, root);
+    reader.Next(); // Throws if anything follows the root
+    return root;
+}
+
+std::string JsonObject::ToBinary(const BinaryFormat format) const
+{
+    std::string out;
+    BinaryWriter writer(out, format);
+    WriteBinary(writer);
+    return out;
+}
+
+void JsonObject::WriteBinary(BinaryWriter& writer) const
+{
+    writer.BeginMap(mValues.size());
+    for (const auto& [key, value] : mValues)
+    {
+        writer.WriteString(key);
+        value.WriteBinary(writer);
+    }
+}
+
+} // namespace cereal
@@ -0,0 +1,198 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Builder.cpp
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "Builder.h"
+#include "Writer.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace cereal
+{
+
+JsonBuilder::JsonBuilder(const size_t shards) :
+    mShards(std::make_unique<Shard[]>(std::bit_ceil((std::max)(shards, size_t{ 1 })))),
+    mMask(std::bit_ceil((std::max)(shards, size_t{ 1 })) - 1)
+{}
+
+JsonBuilder& JsonBuilder::Object(const std::string_view key, const size_t shards)
+{
+    Shard&          shard = ShardOf(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto found = shard.members.find(key);
+    if (found == shard.members.end())
+    {
+        found = shard.members.emplace(std::string(key), Member{ {}, std::make_unique<JsonBuilder>(shards) }).first;
+    } else if (!found->second.object)
+    {
+        found->second.value.ThrowTypeMismatch(GetTypeName<std::shared_ptr<JsonObject>>(), key);
+    }
+    return *found->second.object;
+}
+
+size_t JsonBuilder::Size() const
+{
+    size_t size = 0;
+    for (size_t i = 0; i <= mMask; ++i)
+    {
+        size += mShards[i].members.size();
+    }
+    return size;
+}
+
+JsonObject JsonBuilder::Freeze()
+{
+    JsonObject object;
+    FreezeInto(object);
+    return object;
+}
+
+std::string JsonBuilder::ToString(bool pretty, int indentLevel, int indentSize) const
+{
+    std::string out;
+    JsonWriter  writer(out);
+    Write(writer, pretty, indentLevel, indentSize);
+    return out;
+}
+
+void JsonBuilder::Write(JsonWriter& writer, bool pretty, int indentLevel, int indentSize) const
+{
+    if (pretty)
+    {
+        WriteObject<PrettyOutput>(writer, indentLevel, indentSize);
+    } else
+    {
+        WriteObject<CompactOutput>(writer, indentLevel, indentSize);
+    }
+}
+
+JsonBuilder::Shard& JsonBuilder::ShardOf(const std::string_view key) const
+{
+    return mShards[StringHash{}(key) & mMask];
+}
+
+void JsonBuilder::Store(const std::string_view key, JsonValue&& value)
+{
+    Shard&    shard = ShardOf(key);
+    JsonValue replaced; // Released after the lock is
+    {
+        std::lock_guard lock(shard.mutex);
+
+        const auto found = shard.members.find(key);
+        if (found == shard.members.end())
+        {
+            shard.members.emplace(std::string(key), Member{ std::move(value), nullptr });
+            return;
+        }
+        if (found->second.object)
+        {
+            throw std::runtime_error("Key holds a nested builder in JsonBuilder: " + std::string(key));
+        }
+        replaced = std::exchange(found->second.value, std::move(value));
+    }
+}
+
+std::vector<JsonBuilder::MemberMap::value_type*> JsonBuilder::Sorted() const
+{
+    std::vector<MemberMap::value_type*> members;
+    members.reserve(Size());
+    for (size_t i = 0; i <= mMask; ++i)
+    {
+        for (auto& member : mShards[i].members)
+        {
+            members.push_back(&member);
+        }
+    }
+
+    // Comparing string_views compares bytes as unsigned, which for utf-8 keys is the same as comparing code points
+    std::sort(members.begin(), members.end(), [](const auto* lhs, const auto* rhs) {
+        return std::string_view(lhs->first) < std::string_view(rhs->first);
+    });
+    return members;
+}
+
+void JsonBuilder::FreezeInto(JsonObject& object)
+{
+    for (auto* const member : Sorted())
+    {
+        auto& [key, entry] = *member;
+        if (entry.object)
+        {
+            std::shared_ptr<JsonObject> child = object.CreateObject();
+            entry.object->FreezeInto(*child);
+            object.Add(key, std::move(child));
+        } else
+        {
+            object.Add(key, std::move(entry.value));
+        }
+    }
+
+    for (size_t i = 0; i <= mMask; ++i)
+    {
+        mShards[i].members.clear();
+    }
+}
+
+template<typename Output>
+void JsonBuilder::WriteObject(JsonWriter& writer, const int indentLevel, const int indentSize) const
+{
+    writer.Append(Output::Pretty ? "{\n" : "{");
+
+    bool first = true;
+    for (const auto* const member : Sorted())
+    {
+        const auto& [key, entry] = *member;
+        if (!first)
+        {
+            writer.Append(Output::Pretty ? ", \n" : ", ");
+        }
+        first = false;
+
+        if constexpr (Output::Pretty)
+        {
+            writer.AppendIndent(static_cast<size_t>(indentLevel + 1) * indentSize);
+        }
+        writer.AppendString(key);
+        writer.Append(": ");
+
+        if (entry.object)
+        {
+            entry.object->WriteObject<Output>(writer, indentLevel + 1, indentSize);
+        } else
+        {
+            writer.AppendValue(entry.value);
+        }
+        writer.MaybeFlush();
+    }
+
+    if constexpr (Output::Pretty)
+    {
+        writer.AppendNewLine(static_cast<size_t>(indentLevel) * indentSize);
+    }
+    writer.Append('}');
+}
+
+} // namespace cereal
@@ -0,0 +1,275 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Escape
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#include "Escape.h"
+
+#include "Simd.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace cereal
+{
+
+namespace
+{
+
+// 0 for characters that can be copied as is, otherwise the character that follows the backslash ('u' for \u00XX)
+constexpr std::array<char, 256> EscapeTable = [] {
+    std::array<char, 256> table{};
+    for (int c = 0; c < 0x20; ++c)
+    {
+        table[c] = 'u';
+    }
+    table['"']  = '"';
+    table['\\'] = '\\';
+    table['\b'] = 'b';
+    table['\f'] = 'f';
+    table['\n'] = 'n';
+    table['\r'] = 'r';
+    table['\t'] = 't';
+    return table;
+}();
+
+void AppendEscape(std::string& out, const unsigned char c)
+{
+    constexpr char hex[] = "0123456789abcdef";
+
+    const char escape = EscapeTable[c];
+    if (escape == 'u')
+    {
+        const char sequence[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+        out.append(sequence, sizeof(sequence));
+    } else
+    {
+        const char sequence[] = { '\\', escape };
+        out.append(sequence, sizeof(sequence));
+    }
+}
+
+// Each scanner returns the offset of the first character at or after pos that needs escaping, or size if none does
+
+size_t FindEscapeScalar(const char* data, size_t pos, const size_t size)
+{
+    while (pos < size && !EscapeTable[static_cast<unsigned char>(data[pos])])
+    {
+        ++pos;
+    }
+    return pos;
+}
+
+#ifdef CEREAL_SIMD_SSE2
+
+size_t FindEscapeSse2(const char* data, size_t pos, const size_t size)
+{
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control   = _mm_set1_epi8(0x1F);
+
+    for (; pos + 16 <= size; pos += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+
+        // max(c, 0x1F) == 0x1F exactly when c <= 0x1F as an unsigned byte
+        const __m128i needsEscape = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                                 _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+
+        if (const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(needsEscape)))
+        {
+            return pos + detail::CountTrailingZeros(mask);
+        }
+    }
+    return FindEscapeScalar(data, pos, size);
+}
+
+CEREAL_TARGET_AVX2 size_t FindEscapeAvx2(const char* data, size_t pos, const size_t size)
+{
+    const __m256i quote     = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control   = _mm256_set1_epi8(0x1F);
+
+    for (; pos + 32 <= size; pos += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+
+        const __m256i needsEscape =
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                            _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+
+        if (const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(needsEscape)))
+        {
+            return pos + detail::CountTrailingZeros(mask);
+        }
+    }
+    return FindEscapeSse2(data, pos, size);
+}
+
+size_t FindEscape(const char* data, const size_t pos, const size_t size)
+{
+    return detail::CpuHasAvx2() ? FindEscapeAvx2(data, pos, size) : FindEscapeSse2(data, pos, size);
+}
+
+#else
+
+size_t FindEscape(const char* data, const size_t pos, const size_t size)
+{
+    return FindEscapeScalar(data, pos, size);
+}
+
+#endif
+
+uint32_t ReadHex4(const std::string_view text, const size_t pos)
+{
+    if (pos + 4 > text.size())
+    {
+        throw std::runtime_error("Invalid \\u escape in json string");
+    }
+
+    uint32_t value = 0;
+    for (size_t i = pos; i < pos + 4; ++i)
+    {
+        const char c = text[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9')
+        {
+            value |= c - '0';
+        } else if (c >= 'a' && c <= 'f')
+        {
+            value |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F')
+        {
+            value |= c - 'A' + 10;
+        } else
+        {
+            throw std::runtime_error("Invalid \\u escape in json string");
+        }
+    }
+    return value;
+}
+
+void AppendUtf8(std::string& out, const uint32_t codepoint)
+{
+    if (codepoint < 0x80)
+    {
+        out += static_cast<char>(codepoint);
+    } else if (codepoint < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (codepoint >> 6));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (codepoint >> 12));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else
+    {
+        out += static_cast<char>(0xF0 | (codepoint >> 18));
+        out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+}
+
+} // namespace
+
+void WriteUnescaped(std::string& out, const std::string_view text)
+{
+    size_t runStart = 0;
+    while (runStart < text.size())
+    {
+        const void*  found = std::memchr(text.data() + runStart, '\\', text.size() - runStart);
+        const size_t pos   = found ? static_cast<const char*>(found) - text.data() : text.size();
+
+        out.append(text.data() + runStart, pos - runStart);
+        if (pos == text.size())
+        {
+            break;
+        }
+        if (pos + 1 == text.size())
+        {
+            throw std::runtime_error("Json string ends in a lone backslash");
+        }
+
+        runStart = pos + 2;
+        switch (text[pos + 1])
+        {
+        case '"': out += '"'; break;
+        case '\\': out += '\\'; break;
+        case '/': out += '/'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'u':
+        {
+            uint32_t codepoint = ReadHex4(text, pos + 2);
+            runStart           = pos + 6;
+
+            if (codepoint >= 0xD800 && codepoint <= 0xDBFF && runStart + 1 < text.size() && text[runStart] == '\\' &&
+                text[runStart + 1] == 'u')
+            {
+                const uint32_t low = ReadHex4(text, runStart + 2);
+                if (low >= 0xDC00 && low <= 0xDFFF)
+                {
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    runStart += 6;
+                }
+            }
+            AppendUtf8(out, codepoint);
+            break;
+        }
+        default: throw std::runtime_error(std::string("Invalid escape '\\") + text[pos + 1] + "' in json string");
+        }
+    }
+}
+
+void WriteEscaped(std::string& out, const std::string_view text)
+{
+    const char*  data = text.data();
+    const size_t size = text.size();
+
+    size_t runStart = 0;
+    while (runStart < size)
+    {
+        const size_t pos = FindEscape(data, runStart, size);
+        out.append(data + runStart, pos - runStart);
+        if (pos == size)
+        {
+            break;
+        }
+        AppendEscape(out, static_cast<unsigned char>(data[pos]));
+        runStart = pos + 1;
+    }
+}
+
+void WriteEscapedString(std::string& out, const std::string_view text)
+{
+    out += '"';
+    WriteEscaped(out, text);
+    out += '"';
+}
+
+} // namespace cereal
@@ -0,0 +1,239 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: FileIo
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "FileIo.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+namespace cereal::detail
+{
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string_view filename)
+{
+    const std::string name(filename);
+    mFile = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE)
+    {
+        mFile = nullptr;
+        throw std::runtime_error("Failed to open file for reading");
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(mFile, &size))
+    {
+        CloseHandle(mFile);
+        throw std::runtime_error("Failed to read the size of the file");
+    }
+    mSize = static_cast<size_t>(size.QuadPart);
+
+    // Empty files can't be mapped, and there is nothing to map anyway
+    if (mSize > 0)
+    {
+        mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        mData    = mMapping ? static_cast<const char*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        if (!mData)
+        {
+            if (mMapping)
+            {
+                CloseHandle(mMapping);
+            }
+            CloseHandle(mFile);
+            throw std::runtime_error("Failed to map file");
+        }
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (mData)
+    {
+        UnmapViewOfFile(mData);
+        CloseHandle(mMapping);
+    }
+    CloseHandle(mFile);
+}
+
+FileOutput::FileOutput(const std::string_view filename)
+{
+    const std::string name(filename);
+    mFile = CreateFileA(name.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE)
+    {
+        mFile = nullptr;
+        throw std::runtime_error("Failed to open file for writing");
+    }
+}
+
+FileOutput::FileOutput(const int descriptor) : mOwned(false)
+{
+    const intptr_t handle = _get_osfhandle(descriptor);
+    if (handle == -1)
+    {
+        throw std::runtime_error("Invalid file descriptor");
+    }
+    mFile = reinterpret_cast<void*>(handle);
+}
+
+FileOutput::~FileOutput()
+{
+    if (mOwned)
+    {
+        CloseHandle(mFile);
+    }
+}
+
+std::streamsize FileOutput::xsputn(const char* data, const std::streamsize count)
+{
+    std::streamsize written = 0;
+    while (written < count)
+    {
+        const DWORD chunk = static_cast<DWORD>((std::min<std::streamsize>)(count - written, 1 << 30));
+        DWORD       done  = 0;
+        if (!WriteFile(mFile, data + written, chunk, &done, nullptr))
+        {
+            break;
+        }
+        written += done;
+    }
+    return written;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string_view filename)
+{
+    const std::string name(filename);
+    const int         file = open(name.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0)
+    {
+        throw std::runtime_error("Failed to open file for reading");
+    }
+
+    struct stat info{};
+    if (fstat(file, &info) != 0)
+    {
+        close(file);
+        throw std::runtime_error("Failed to read the size of the file");
+    }
+    mSize = static_cast<size_t>(info.st_size);
+
+    // Empty files can't be mapped, and there is nothing to map anyway. The mapping stays valid after the descriptor
+    // is closed
+    if (mSize > 0)
+    {
+        void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED)
+        {
+            close(file);
+            throw std::runtime_error("Failed to map file");
+        }
+        madvise(data, mSize, MADV_SEQUENTIAL);
+        mData = static_cast<const char*>(data);
+    }
+    close(file);
+}
+
+MappedFile::~MappedFile()
+{
+    if (mData)
+    {
+        munmap(const_cast<char*>(mData), mSize);
+    }
+}
+
+FileOutput::FileOutput(const std::string_view filename)
+{
+    const std::string name(filename);
+    mFile = open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (mFile < 0)
+    {
+        throw std::runtime_error("Failed to open file for writing");
+    }
+}
+
+FileOutput::FileOutput(const int descriptor) : mFile(descriptor), mOwned(false)
+{
+    if (descriptor < 0)
+    {
+        throw std::runtime_error("Invalid file descriptor");
+    }
+}
+
+FileOutput::~FileOutput()
+{
+    if (mOwned)
+    {
+        close(mFile);
+    }
+}
+
+std::streamsize FileOutput::xsputn(const char* data, const std::streamsize count)
+{
+    std::streamsize written = 0;
+    while (written < count)
+    {
+        const ssize_t done = write(mFile, data + written, static_cast<size_t>(count - written));
+        if (done < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        written += done;
+    }
+    return written;
+}
+
+#endif
+
+FileOutput::int_type FileOutput::overflow(const int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        return traits_type::not_eof(c);
+    }
+
+    const char byte = traits_type::to_char_type(c);
+    return xsputn(&byte, 1) == 1 ? c : traits_type::eof();
+}
+
+} // namespace cereal::detail
@@ -0,0 +1,83 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: FileIo.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <streambuf>
+#include <string_view>
+
+namespace cereal::detail
+{
+
+// A whole file mapped read only. The mapping lasts as long as the object does
+class MappedFile
+{
+public:
+    // Throws std::runtime_error if the file can't be opened or mapped
+    explicit MappedFile(std::string_view filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::string_view View() const { return { mData, mSize }; }
+
+private:
+    const char* mData = nullptr;
+    size_t      mSize = 0;
+#ifdef _WIN32
+    void* mFile    = nullptr;
+    void* mMapping = nullptr;
+#endif
+};
+
+// Unbuffered stream buffer over a file that hands every write straight to the OS, so a JsonWriter flushing into it
+// costs one system call per chunk and no copy into a stream's own buffer
+class FileOutput : public std::streambuf
+{
+public:
+    // Creates or truncates the file. Throws std::runtime_error if that fails
+    explicit FileOutput(std::string_view filename);
+
+    // Writes to a descriptor that is already open, such as a pipe or a socket, and leaves it open afterwards
+    explicit FileOutput(int descriptor);
+    ~FileOutput() override;
+
+    FileOutput(const FileOutput&)            = delete;
+    FileOutput& operator=(const FileOutput&) = delete;
+
+protected:
+    std::streamsize xsputn(const char* data, std::streamsize count) override;
+    int_type        overflow(int_type c) override;
+
+private:
+#ifdef _WIN32
+    void* mFile = nullptr;
+#else
+    int mFile = -1;
+#endif
+    bool mOwned = true;
+};
+
+} // namespace cereal::detail
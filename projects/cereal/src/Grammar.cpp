@@ -0,0 +1,177 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Grammar.cpp
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "Grammar.h"
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+namespace cereal::detail
+{
+
+void ThrowParseError(const std::string_view message, const size_t offset)
+{
+    throw std::runtime_error("Json parse error at offset " + std::to_string(offset) + ": " + std::string(message));
+}
+
+std::string_view ScalarToken(const std::string_view json, const size_t offset, const size_t limit)
+{
+    size_t end = offset;
+    while (end < limit && json[end] != ' ' && json[end] != '\n' && json[end] != '\r' && json[end] != '\t')
+    {
+        ++end;
+    }
+    return json.substr(offset, end - offset);
+}
+
+bool IsJsonNumber(const std::string_view token)
+{
+    size_t     i      = 0;
+    const auto digits = [&token, &i] {
+        const size_t start = i;
+        while (i < token.size() && token[i] >= '0' && token[i] <= '9')
+        {
+            ++i;
+        }
+        return i - start;
+    };
+
+    if (i < token.size() && token[i] == '-')
+    {
+        ++i;
+    }
+    if (i < token.size() && token[i] == '0')
+    {
+        ++i;
+    } else if (digits() == 0)
+    {
+        return false;
+    }
+    if (i < token.size() && token[i] == '.')
+    {
+        ++i;
+        if (digits() == 0)
+        {
+            return false;
+        }
+    }
+    if (i < token.size() && (token[i] == 'e' || token[i] == 'E'))
+    {
+        ++i;
+        if (i < token.size() && (token[i] == '+' || token[i] == '-'))
+        {
+            ++i;
+        }
+        if (digits() == 0)
+        {
+            return false;
+        }
+    }
+    return i == token.size();
+}
+
+JsonNumber ParseJsonNumber(const std::string_view token, const size_t offset)
+{
+    const char* first = token.data();
+    const char* last  = token.data() + token.size();
+
+    // from_chars would also take inf, nan, hex floats, leading zeros and a bare '.' or exponent, none of which are json
+    const size_t digit = !token.empty() && token[0] == '-' ? 1 : 0;
+    if (digit >= token.size() || token[digit] < '0' || token[digit] > '9')
+    {
+        ThrowParseError("invalid literal '" + std::string(token) + "'", offset);
+    }
+    if (!IsJsonNumber(token))
+    {
+        ThrowParseError("invalid number '" + std::string(token) + "'", offset);
+    }
+
+    JsonNumber number;
+    if (token.find_first_of(".eE") == std::string_view::npos)
+    {
+        const auto [ptr, errcode] = std::from_chars(first, last, number.integer);
+        if (errcode == std::errc() && ptr == last)
+        {
+            number.value = number.integer;
+            number.isInt = true;
+            return number;
+        }
+        // Integers too large for an int fall through to double
+    }
+
+    const auto [ptr, errcode] = std::from_chars(first, last, number.value);
+    if (errcode != std::errc() || ptr != last)
+    {
+        ThrowParseError("invalid number '" + std::string(token) + "'", offset);
+    }
+    return number;
+}
+
+ArrayKind ArrayKindOf(const char first, const size_t offset)
+{
+    switch (first)
+    {
+    case '[': ThrowParseError("nested arrays are not supported by JsonObject", offset);
+    case 'n': ThrowParseError("null inside arrays is not supported by JsonObject", offset);
+    case '"': return ArrayKind::Strings;
+    case '{': return ArrayKind::Objects;
+    case 't':
+    case 'f': return ArrayKind::Bools;
+    default: return ArrayKind::Numbers;
+    }
+}
+
+void CheckArrayElement(const ArrayKind kind, const char c, const size_t offset)
+{
+    bool fits = false;
+    switch (kind)
+    {
+    case ArrayKind::Strings: fits = c == '"'; break;
+    case ArrayKind::Objects: fits = c == '{'; break;
+    default: fits = c != '"' && c != '{' && c != '[' && c != ']' && c != ',' && c != ':'; break;
+    }
+    if (!fits)
+    {
+        ThrowParseError("arrays mixing different types are not supported by JsonObject", offset);
+    }
+}
+
+bool ParseBoolElement(const std::string_view token, const size_t offset)
+{
+    if (token != "true" && token != "false")
+    {
+        ThrowParseError("arrays mixing different types are not supported by JsonObject", offset);
+    }
+    return token == "true";
+}
+
+void NumberElements::Add(const std::string_view token, const size_t offset)
+{
+    const JsonNumber number = ParseJsonNumber(token, offset);
+    allInt &= number.isInt;
+    values.push_back(number.value);
+}
+
+} // namespace cereal::detail
@@ -0,0 +1,85 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Grammar.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace cereal::detail
+{
+
+// The rules Parse and LazyDocument share for what sits between the structural characters, so both accept exactly the
+// same documents and reject the rest with the same errors. Every error is a std::runtime_error naming the offset
+
+[[noreturn]] void ThrowParseError(std::string_view message, size_t offset);
+
+// The number or literal starting at offset, up to limit or the first whitespace before it
+[[nodiscard]] std::string_view ScalarToken(std::string_view json, size_t offset, size_t limit);
+
+// The number grammar of RFC 8259: an optional minus, an integer part without leading zeros, then an optional fraction
+// and exponent, each with at least one digit
+[[nodiscard]] bool IsJsonNumber(std::string_view token);
+
+// Integers that fit in an int are read as one, every other number as a double
+struct JsonNumber
+{
+    double value   = 0.0;
+    int    integer = 0;
+    bool   isInt   = false;
+};
+
+[[nodiscard]] JsonNumber ParseJsonNumber(std::string_view token, size_t offset);
+
+// What every element of an array is. Arrays hold a single type, decided by the first character of the first element
+enum class ArrayKind : uint8_t
+{
+    Strings,
+    Objects,
+    Bools,
+    Numbers
+};
+
+// Throws for nested arrays and nulls, neither of which a JsonObject array can hold
+[[nodiscard]] ArrayKind ArrayKindOf(char first, size_t offset);
+
+// Throws unless an element starting with c belongs in an array of kind
+void CheckArrayElement(ArrayKind kind, char c, size_t offset);
+
+// An element of an array of bools
+[[nodiscard]] bool ParseBoolElement(std::string_view token, size_t offset);
+
+// The elements of an array of numbers, kept as doubles until the end decides whether they were all ints
+struct NumberElements
+{
+    std::vector<double> values;
+    bool                allInt = true;
+
+    void Add(std::string_view token, size_t offset);
+
+    [[nodiscard]] std::vector<int> Integers() const { return std::vector<int>(values.begin(), values.end()); }
+};
+
+} // namespace cereal::detail
@@ -0,0 +1,376 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Instrument.cpp
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#include "Instrument.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace cereal
+{
+
+namespace
+{
+
+constexpr std::string_view OperationNames[] = { "ToString", "PrintToFile", "Serialize", "Parse", "ParseFile", "MapFile" };
+constexpr std::string_view PhaseNames[]     = { "Read", "Index", "Build", "Walk", "Values", "Io" };
+
+static_assert(std::size(OperationNames) == static_cast<size_t>(Operation::Count));
+static_assert(std::size(PhaseNames) == static_cast<size_t>(Phase::Count));
+
+#if CEREAL_INSTRUMENT
+
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point gEpoch = Clock::now();
+
+int64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - gEpoch).count();
+}
+
+struct TraceEvent
+{
+    std::string_view name;
+    std::string_view category;
+    uint32_t         thread;
+    int64_t          start;
+    int64_t          duration;
+    uint64_t         bytes; // Operations only
+    uint64_t         nodes;
+};
+
+struct Recorder
+{
+    std::mutex              mutex;
+    InstrumentStats         stats;
+    std::atomic<bool>       tracing = false;
+    std::vector<TraceEvent> events;
+};
+
+Recorder& GetRecorder()
+{
+    // Never destroyed, so operations run while other statics are destroyed can still be recorded
+    static Recorder* recorder = new Recorder();
+    return *recorder;
+}
+
+thread_local detail::InstrumentContext* tOperation = nullptr; // Running on this thread
+thread_local detail::InstrumentContext* tCounters  = nullptr; // Counts made on this thread go to it
+
+// Small numbers read better than the platform's thread ids in a trace viewer
+uint32_t ThreadId()
+{
+    static std::atomic<uint32_t> next = 0;
+    thread_local const uint32_t  id   = ++next;
+    return id;
+}
+
+// Gives the time since the last change of phase to the phase the operation is in
+void Charge(detail::InstrumentContext& context, const int64_t now)
+{
+    context.phaseNanoseconds[static_cast<size_t>(context.phase)] += now - context.phaseStart;
+    context.phaseStart = now;
+}
+
+void RecordEvent(const std::string_view name, const std::string_view category, const int64_t start, const int64_t end,
+                 const uint64_t bytes = 0, const uint64_t nodes = 0)
+{
+    Recorder& recorder = GetRecorder();
+    if (!recorder.tracing.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    const std::lock_guard lock(recorder.mutex);
+    recorder.events.push_back({ name, category, ThreadId(), start, end - start, bytes, nodes });
+}
+
+#endif
+
+} // namespace
+
+std::string_view OperationName(const Operation operation)
+{
+    return OperationNames[static_cast<size_t>(operation)];
+}
+
+std::string_view PhaseName(const Phase phase)
+{
+    return PhaseNames[static_cast<size_t>(phase)];
+}
+
+std::string InstrumentStats::ToString() const
+{
+    char        line[256];
+    std::string out;
+
+    std::snprintf(line, sizeof(line), "%-12s %8s %10s %10s %10s %10s", "operation", "calls", "ms", "MB", "nodes",
+                  "allocs");
+    out += line;
+    for (const std::string_view phase : PhaseNames)
+    {
+        std::snprintf(line, sizeof(line), " %8.*s", static_cast<int>(phase.size()), phase.data());
+        out += line;
+    }
+    out += '\n';
+
+    for (size_t i = 0; i < operations.size(); ++i)
+    {
+        const OperationStats& stats = operations[i];
+        if (stats.calls == 0)
+        {
+            continue;
+        }
+
+        std::snprintf(line, sizeof(line), "%-12.*s %8llu %10.3f %10.3f %10llu %10llu",
+                      static_cast<int>(OperationNames[i].size()), OperationNames[i].data(),
+                      static_cast<unsigned long long>(stats.calls), stats.seconds * 1e3,
+                      static_cast<double>(stats.bytes) / (1024.0 * 1024.0), static_cast<unsigned long long>(stats.nodes),
+                      static_cast<unsigned long long>(stats.allocations));
+        out += line;
+        for (const double seconds : stats.phaseSeconds)
+        {
+            std::snprintf(line, sizeof(line), " %8.3f", seconds * 1e3);
+            out += line;
+        }
+        out += '\n';
+    }
+    return out;
+}
+
+InstrumentStats GetInstrumentStats()
+{
+#if CEREAL_INSTRUMENT
+    Recorder&             recorder = GetRecorder();
+    const std::lock_guard lock(recorder.mutex);
+    return recorder.stats;
+#else
+    return {};
+#endif
+}
+
+void ResetInstrumentStats()
+{
+#if CEREAL_INSTRUMENT
+    Recorder&             recorder = GetRecorder();
+    const std::lock_guard lock(recorder.mutex);
+    recorder.stats = {};
+#endif
+}
+
+void StartTrace()
+{
+#if CEREAL_INSTRUMENT
+    Recorder&             recorder = GetRecorder();
+    const std::lock_guard lock(recorder.mutex);
+    recorder.events.clear();
+    recorder.tracing.store(true, std::memory_order_relaxed);
+#endif
+}
+
+void StopTrace()
+{
+#if CEREAL_INSTRUMENT
+    GetRecorder().tracing.store(false, std::memory_order_relaxed);
+#endif
+}
+
+void WriteTrace(const std::string_view filename)
+{
+    std::ofstream fs{ std::string(filename) };
+
+    if (!fs.is_open())
+    {
+        throw std::runtime_error("Failed to open file for writing");
+    }
+
+    fs << "{\"traceEvents\": [";
+#if CEREAL_INSTRUMENT
+    Recorder&             recorder = GetRecorder();
+    const std::lock_guard lock(recorder.mutex);
+
+    char line[256];
+    bool first = true;
+    for (const TraceEvent& event : recorder.events)
+    {
+        // Timestamps are in microseconds
+        std::snprintf(line, sizeof(line),
+                      "%s\n{\"name\": \"%.*s\", \"cat\": \"%.*s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, "
+                      "\"dur\": %.3f",
+                      first ? "" : ",", static_cast<int>(event.name.size()), event.name.data(),
+                      static_cast<int>(event.category.size()), event.category.data(), event.thread,
+                      static_cast<double>(event.start) / 1e3, static_cast<double>(event.duration) / 1e3);
+        fs << line;
+        if (event.category == "operation")
+        {
+            std::snprintf(line, sizeof(line), ", \"args\": {\"bytes\": %llu, \"nodes\": %llu}",
+                          static_cast<unsigned long long>(event.bytes), static_cast<unsigned long long>(event.nodes));
+            fs << line;
+        }
+        fs << '}';
+        first = false;
+    }
+#endif
+    fs << "\n], \"displayTimeUnit\": \"ms\"}\n";
+
+    if (!fs)
+    {
+        throw std::runtime_error("Failed to write file");
+    }
+}
+
+#if CEREAL_INSTRUMENT
+
+namespace detail
+{
+
+OperationScope::OperationScope(const Operation operation, const Phase phase) :
+    mContext{ .operation = operation, .phase = phase }, mPrevious(tCounters), mOuter(tOperation == nullptr)
+{
+    if (!mOuter)
+    {
+        return;
+    }
+
+    mContext.start      = Now();
+    mContext.phaseStart = mContext.start;
+    tOperation          = &mContext;
+    tCounters           = &mContext;
+}
+
+OperationScope::~OperationScope()
+{
+    if (!mOuter)
+    {
+        return;
+    }
+
+    const int64_t end = Now();
+    Charge(mContext, end);
+    tOperation = nullptr;
+    tCounters  = mPrevious;
+
+    Recorder&             recorder = GetRecorder();
+    const std::lock_guard lock(recorder.mutex);
+
+    OperationStats& stats = recorder.stats.operations[static_cast<size_t>(mContext.operation)];
+    ++stats.calls;
+    stats.allocations += mContext.allocations.load(std::memory_order_relaxed);
+    stats.allocatedBytes += mContext.allocatedBytes.load(std::memory_order_relaxed);
+    stats.bytes += mContext.bytes.load(std::memory_order_relaxed);
+    stats.nodes += mContext.nodes.load(std::memory_order_relaxed);
+    stats.seconds += static_cast<double>(end - mContext.start) / 1e9;
+    for (size_t i = 0; i < stats.phaseSeconds.size(); ++i)
+    {
+        stats.phaseSeconds[i] += static_cast<double>(mContext.phaseNanoseconds[i]) / 1e9;
+    }
+
+    if (recorder.tracing.load(std::memory_order_relaxed))
+    {
+        recorder.events.push_back({ OperationName(mContext.operation), "operation", ThreadId(), mContext.start,
+                                    end - mContext.start, mContext.bytes.load(std::memory_order_relaxed),
+                                    mContext.nodes.load(std::memory_order_relaxed) });
+    }
+}
+
+PhaseScope::PhaseScope(const Phase phase) : mContext(tOperation), mPhase(phase), mPrevious(phase), mStart(0)
+{
+    if (!mContext)
+    {
+        return;
+    }
+
+    mStart = Now();
+    Charge(*mContext, mStart);
+    mPrevious       = mContext->phase;
+    mContext->phase = phase;
+}
+
+PhaseScope::~PhaseScope()
+{
+    if (!mContext)
+    {
+        return;
+    }
+
+    const int64_t end = Now();
+    Charge(*mContext, end);
+    mContext->phase = mPrevious;
+
+    // Values are far too fine grained to be worth an event each
+    if (mPhase != Phase::Values)
+    {
+        RecordEvent(PhaseName(mPhase), "phase", mStart, end);
+    }
+}
+
+InstrumentContext* CurrentInstrumentContext()
+{
+    return tCounters;
+}
+
+AttachScope::AttachScope(InstrumentContext* context) : mPrevious(tCounters)
+{
+    tCounters = context;
+}
+
+AttachScope::~AttachScope()
+{
+    tCounters = mPrevious;
+}
+
+void CountAllocation(const size_t bytes)
+{
+    if (InstrumentContext* context = tCounters)
+    {
+        context->allocations.fetch_add(1, std::memory_order_relaxed);
+        context->allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void CountBytes(const size_t bytes)
+{
+    if (InstrumentContext* context = tCounters)
+    {
+        context->bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void CountNodes(const size_t nodes)
+{
+    if (InstrumentContext* context = tCounters)
+    {
+        context->nodes.fetch_add(nodes, std::memory_order_relaxed);
+    }
+}
+
+} // namespace detail
+
+#endif
+
+} // namespace cereal
@@ -23,72 +23,437 @@
 
 #include "Json.h"
 #include "Serializer.h"
+#include "FileIo.h"
+#include "ThreadPool.h"
 
+#include <algorithm>
 #include <fstream>
+#include <vector>
 
 namespace cereal
 {
 
-void JsonObject::Add(const std::string& key, JsonValue value)
+namespace
 {
-    mValues[key] = std::move(value);
+
+// Objects and arrays smaller than this are written on the calling thread, splitting them costs more than it saves
+constexpr size_t ParallelMinMembers  = 64;
+constexpr size_t ParallelMinElements = 4096;
+
+// Smallest piece worth handing to another thread
+constexpr size_t MinChunkMembers  = 16;
+constexpr size_t MinChunkElements = 1024;
+
+// More chunks than threads, so a thread whose chunks happened to be cheap can take over some of the rest
+constexpr size_t ChunksPerThread = 4;
+
+size_t ChunkCount(const size_t items, const size_t minChunk, const ThreadPool& pool)
+{
+    return std::clamp<size_t>(items / minChunk, 1, pool.Size() * ChunksPerThread);
+}
+
+// Start of chunk index when items are shared out as evenly as possible, chunk count being one past the end
+size_t ChunkStart(const size_t items, const size_t chunks, const size_t index)
+{
+    return items * index / chunks;
+}
+
+// Every chunk is written as an array of its own, so joining them is a matter of dropping their brackets and putting
+// the separator back in between
+void WriteElements(JsonWriter& writer, const JsonValue& value, ThreadPool& pool)
+{
+    const size_t             count = value.ElementCount();
+    std::vector<std::string> chunks(ChunkCount(count, MinChunkElements, pool));
+
+    CEREAL_INSTRUMENT_CAPTURE(context);
+    pool.ForEach(chunks.size(), [&](const size_t i) {
+        CEREAL_INSTRUMENT_ATTACH(context);
+        const size_t first = ChunkStart(count, chunks.size(), i);
+        value.WriteElements(chunks[i], first, ChunkStart(count, chunks.size(), i + 1) - first);
+    });
+
+    writer.Append('[');
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        if (i != 0)
+        {
+            writer.Append(", ");
+        }
+        writer.Append(std::string_view(chunks[i]).substr(1, chunks[i].size() - 2));
+        writer.MaybeFlush();
+    }
+    writer.Append(']');
+}
+
+// Like the array Serializer writes it, but with a splice for every object in it instead of its text
+template<typename E>
+void SpliceElements(JsonWriter& writer, const std::span<E> elements, detail::OutputCache& cache)
+{
+    CEREAL_INSTRUMENT_NODES(elements.size());
+
+    writer.Append('[');
+    for (size_t i = 0; i < elements.size(); ++i)
+    {
+        if (i != 0)
+        {
+            writer.Append(", ");
+        }
+
+        const JsonObject* child = nullptr;
+        if constexpr (std::is_same_v<E, JsonObject>)
+        {
+            child = &elements[i];
+        } else
+        {
+            child = elements[i].get();
+        }
+
+        if (child)
+        {
+            cache.splices.push_back({ writer.Buffer().size(), child, true });
+        } else
+        {
+            writer.AppendValue(nullptr);
+        }
+    }
+    writer.Append(']');
 }
 
-void JsonObject::PrintToFile(const std::string_view filename, bool pretty, int indentSize) const
+} // namespace
+
+std::shared_ptr<JsonObject> JsonObject::CreateObject() const
 {
-    std::ofstream fs(filename.data());
+    std::pmr::memory_resource* resource = GetResource();
+    CEREAL_INSTRUMENT_ALLOCATION(sizeof(JsonObject));
+    return std::allocate_shared<JsonObject>(std::pmr::polymorphic_allocator<JsonObject>(resource), resource);
+}
+
+JsonObject::JsonValue& JsonObject::Slot(const std::string_view key)
+{
+    const auto [it, inserted] = mValues.try_emplace(key);
+    mVersion += inserted;
+    return it->second;
+}
+
+JsonObject::JsonValue& JsonObject::Slot(const HashedKey& key)
+{
+    const auto [it, inserted] = mValues.try_emplace(key);
+    mVersion += inserted;
+    return it->second;
+}
+
+JsonObject::JsonValue& JsonObject::Slot(const Symbol& key)
+{
+    const auto [it, inserted] = mValues.try_emplace(key);
+    mVersion += inserted;
+    return it->second;
+}
+
+void JsonObject::ThrowKeyNotFound(const std::string_view key)
+{
+    throw std::runtime_error("Key not found in JsonObject: " + std::string(key));
+}
+
+JsonObject::JsonValue& JsonObject::ViewSlot(const std::string_view key)
+{
+    const auto [it, inserted] = mValues.try_emplace_view(key);
+    mVersion += inserted;
+    return it->second;
+}
+
+void JsonObject::PrintToFile(const std::string_view filename, bool pretty, int indentSize, const FileIo io) const
+{
+    CEREAL_INSTRUMENT_OPERATION(Operation::PrintToFile, Phase::Io);
+
+    if (io == FileIo::Direct)
+    {
+        detail::FileOutput file(filename);
+        std::ostream       stream(&file);
+
+        JsonWriter writer(stream);
+        Write(writer, pretty, 0, indentSize);
+        writer.Flush();
+
+        if (!stream)
+        {
+            throw std::runtime_error("Failed to write file");
+        }
+        return;
+    }
+
+    std::ofstream fs{ std::string(filename) };
 
     if (!fs.is_open())
     {
         throw std::runtime_error("Failed to open file for writing");
     }
 
-    fs << ToString(pretty, 0, indentSize);
+    JsonWriter writer(fs);
+    Write(writer, pretty, 0, indentSize);
+    writer.Flush();
 }
 
 std::string JsonObject::ToString(bool pretty, int indentLevel, int indentSize) const
 {
-    std::ostringstream oss;
-    const std::string  indent  = pretty ? Indent(indentLevel, indentSize) : "";
-    const std::string  newLine = pretty ? "\n" : "";
+    CEREAL_INSTRUMENT_OPERATION(Operation::ToString, Phase::Walk);
+
+    std::string out;
+    JsonWriter  writer(out);
+    Write(writer, pretty, indentLevel, indentSize);
+    CEREAL_INSTRUMENT_RESULT(out.size());
+    return out;
+}
+
+std::string JsonObject::ToString(ThreadPool& pool, bool pretty, int indentLevel, int indentSize) const
+{
+    CEREAL_INSTRUMENT_OPERATION(Operation::ToString, Phase::Walk);
+
+    std::string out;
+    JsonWriter  writer(out);
+    Write(writer, pool, pretty, indentLevel, indentSize);
+    CEREAL_INSTRUMENT_RESULT(out.size());
+    return out;
+}
+
+void JsonObject::Write(JsonWriter& writer, bool pretty, int indentLevel, int indentSize) const
+{
+    CEREAL_INSTRUMENT_PHASE(Phase::Walk);
+    if (pretty)
+    {
+        WriteObject<PrettyOutput>(writer, nullptr, indentLevel, indentSize);
+    } else
+    {
+        WriteObject<CompactOutput>(writer, nullptr, indentLevel, indentSize);
+    }
+}
+
+void JsonObject::Write(JsonWriter& writer, ThreadPool& pool, bool pretty, int indentLevel, int indentSize) const
+{
+    CEREAL_INSTRUMENT_PHASE(Phase::Walk);
+    ThreadPool* threads = pool.Size() > 1 ? &pool : nullptr;
+    if (pretty)
+    {
+        WriteObject<PrettyOutput>(writer, threads, indentLevel, indentSize);
+    } else
+    {
+        WriteObject<CompactOutput>(writer, threads, indentLevel, indentSize);
+    }
+}
+
+std::string JsonObject::ToStringCached(bool pretty, int indentLevel, int indentSize) const
+{
+    CEREAL_INSTRUMENT_OPERATION(Operation::ToString, Phase::Walk);
 
-    oss << "{" << newLine;
-    bool first = true;
+    std::string out;
+    JsonWriter  writer(out);
+    WriteCached(writer, pretty, indentLevel, indentSize);
+    CEREAL_INSTRUMENT_RESULT(out.size());
+    return out;
+}
 
-    for (const auto& [key, value] : mValues)
+void JsonObject::WriteCached(JsonWriter& writer, bool pretty, int indentLevel, int indentSize) const
+{
+    detail::OutputCache& cache = mCache.Get();
+    if (!cache.filled || cache.version != mVersion || cache.pretty != pretty || cache.indentLevel != indentLevel ||
+        cache.indentSize != indentSize)
     {
-        if (!first)
+        cache.text.clear();
+        cache.splices.clear();
+
+        JsonWriter text(cache.text);
+        if (pretty)
         {
-            oss << ", " << newLine;
+            WriteObject<PrettyOutput>(text, nullptr, indentLevel, indentSize, &cache);
+        } else
+        {
+            WriteObject<CompactOutput>(text, nullptr, indentLevel, indentSize, &cache);
         }
-        oss << indent << Indent(1, indentSize) << "\"" << key << "\": ";
-        std::visit(
-            [&oss, pretty, indentLevel, indentSize, this]<typename T>(const T& v) {
-                if constexpr (std::is_same_v<std::decay_t<T>, std::shared_ptr<JsonObject>>)
-                {
-                    if (v)
-                    {
-                        oss << v->ToString(pretty, indentLevel + 1, indentSize);
 
-                    } else
-                    {
-                        oss << Serialize(nullptr);
-                    }
-                } else if constexpr (std::is_same_v<T, JsonObject>)
-                {
-                    oss << v.ToString(pretty, indentLevel + 1, indentSize);
-                } else
-                {
-                    oss << Serialize(v);
-                }
-            },
-            value);
-        first = false;
+        cache.filled      = true;
+        cache.version     = mVersion;
+        cache.pretty      = pretty;
+        cache.indentLevel = indentLevel;
+        cache.indentSize  = indentSize;
     }
 
-    oss << newLine << indent << "}";
-    return oss.str();
+    const std::string_view text    = cache.text;
+    size_t                 written = 0;
+    for (const auto& [offset, child, element] : cache.splices)
+    {
+        writer.Append(text.substr(written, offset - written));
+        child->WriteCached(writer, pretty && !element, indentLevel + 1, indentSize);
+        writer.MaybeFlush();
+        written = offset;
+    }
+    writer.Append(text.substr(written));
+}
+
+std::string JsonObject::ToCanonicalString() const
+{
+    CEREAL_INSTRUMENT_OPERATION(Operation::ToString, Phase::Walk);
+
+    std::string out;
+    JsonWriter  writer(out);
+    WriteCanonical(writer);
+    CEREAL_INSTRUMENT_RESULT(out.size());
+    return out;
 }
 
+void JsonObject::WriteCanonical(JsonWriter& writer) const
+{
+    CEREAL_INSTRUMENT_PHASE(Phase::Walk);
+    WriteObject<CanonicalOutput>(writer, nullptr, 0, 0);
+}
+
+template<typename Output>
+void JsonObject::WriteObject(JsonWriter& writer, ThreadPool* pool, int indentLevel, int indentSize,
+                             detail::OutputCache* cache) const
+{
+    writer.Append(Output::Pretty ? "{\n" : "{");
+
+    if constexpr (Output::Canonical)
+    {
+        // Comparing string_views compares bytes as unsigned, which for utf-8 keys is the same as comparing code points
+        std::vector<const ValueMap::value_type*> members;
+        members.reserve(mValues.size());
+        for (const auto& member : mValues)
+        {
+            members.push_back(&member);
+        }
+        std::sort(members.begin(), members.end(), [](const auto* lhs, const auto* rhs) {
+            return std::string_view(lhs->first) < std::string_view(rhs->first);
+        });
+
+        for (size_t i = 0; i < members.size(); ++i)
+        {
+            WriteMember<Output>(writer, *members[i], i != 0, nullptr, 0, 0, nullptr);
+        }
+    } else if (pool && mValues.size() >= ParallelMinMembers)
+    {
+        // Members are written one chunk per task, each into its own buffer, and the buffers are joined in order.
+        // Nothing inside a chunk is split any further
+        const size_t             count = mValues.size();
+        std::vector<std::string> chunks(ChunkCount(count, MinChunkMembers, *pool));
+
+        CEREAL_INSTRUMENT_CAPTURE(context);
+        pool->ForEach(chunks.size(), [&](const size_t i) {
+            CEREAL_INSTRUMENT_ATTACH(context);
+            JsonWriter chunk(chunks[i]);
+            for (size_t m = ChunkStart(count, chunks.size(), i); m < ChunkStart(count, chunks.size(), i + 1); ++m)
+            {
+                WriteMember<Output>(chunk, *(mValues.begin() + m), m != 0, nullptr, indentLevel, indentSize, nullptr);
+            }
+        });
+
+        for (const std::string& chunk : chunks)
+        {
+            writer.Append(chunk);
+            writer.MaybeFlush();
+        }
+    } else
+    {
+        bool first = true;
+        for (const auto& member : mValues)
+        {
+            WriteMember<Output>(writer, member, !first, pool, indentLevel, indentSize, cache);
+            first = false;
+        }
+    }
+
+    if constexpr (Output::Pretty)
+    {
+        writer.AppendNewLine(static_cast<size_t>(indentLevel) * indentSize);
+    }
+    writer.Append('}');
+}
+
+template<typename Output>
+void JsonObject::WriteMember(JsonWriter& writer, const ValueMap::value_type& member, bool separator, ThreadPool* pool,
+                             int indentLevel, int indentSize, detail::OutputCache* cache)
+{
+    const auto& [key, value] = member;
+    CEREAL_INSTRUMENT_NODES(1);
+
+    if (separator)
+    {
+        writer.Append(Output::Pretty ? ", \n" : Output::Canonical ? "," : ", ");
+    }
+    if constexpr (Output::Pretty)
+    {
+        writer.AppendIndent(static_cast<size_t>(indentLevel + 1) * indentSize);
+    }
+
+    // A symbol's fragment has the ": " compact and pretty output put after keys already in it
+    const Symbol* symbol = Output::Canonical ? nullptr : key.GetSymbol();
+    if (symbol)
+    {
+        writer.Append(symbol->Fragment());
+    } else
+    {
+        writer.AppendString(key);
+        writer.Append(Output::Canonical ? ":" : ": ");
+    }
+
+    switch (value.GetType())
+    {
+    case JsonType::Object:
+    {
+        const std::shared_ptr<JsonObject>& child = value.Get<std::shared_ptr<JsonObject>>();
+        if (!child)
+        {
+            writer.AppendValue(nullptr);
+        } else if (cache)
+        {
+            cache->splices.push_back({ writer.Buffer().size(), child.get() });
+        } else
+        {
+            child->WriteObject<Output>(writer, pool, indentLevel + 1, indentSize);
+        }
+        break;
+    }
+    case JsonType::InlineObject:
+        if (cache)
+        {
+            cache->splices.push_back({ writer.Buffer().size(), &value.Get<JsonObject>() });
+        } else
+        {
+            value.Get<JsonObject>().WriteObject<Output>(writer, pool, indentLevel + 1, indentSize);
+        }
+        break;
+    case JsonType::Span:
+    case JsonType::Array:
+        if (cache && value.ElementType() == JsonType::Object)
+        {
+            SpliceElements(writer, value.Get<std::span<std::shared_ptr<JsonObject>>>(), *cache);
+            break;
+        }
+        if (cache && value.ElementType() == JsonType::InlineObject)
+        {
+            SpliceElements(writer, value.Get<std::span<JsonObject>>(), *cache);
+            break;
+        }
+        if (pool && value.ElementCount() >= ParallelMinElements)
+        {
+            CEREAL_INSTRUMENT_PHASE(Phase::Values);
+            WriteElements(writer, value, *pool);
+            break;
+        }
+        [[fallthrough]];
+    default:
+    {
+        CEREAL_INSTRUMENT_PHASE(Phase::Values);
+        if constexpr (Output::Canonical)
+        {
+            writer.AppendCanonical(value);
+        } else
+        {
+            writer.AppendValue(value);
+        }
+        break;
+    }
+    }
+
+    writer.MaybeFlush();
+}
 
 } // namespace cereal
\ No newline at end of file
@@ -0,0 +1,568 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Lazy.cpp
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "Lazy.h"
+#include "Escape.h"
+#include "FileIo.h"
+#include "StructuralIndex.h"
+#include "Grammar.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace cereal
+{
+
+namespace detail
+{
+
+struct LazyState
+{
+    static constexpr size_t MaxDepth = 1024;
+
+    std::string           owned;     // The input, when the document made a copy of it
+    std::shared_ptr<void> keepAlive; // Or the mapping it lives in
+    std::string_view      json;
+    std::vector<uint32_t> index;
+    std::vector<uint32_t> match; // For every '{' and '[' entry, the entry of the bracket that closes it
+
+    // Arrays and strings with escapes decoded so far, by the structural index entry they start at. Nothing is ever
+    // removed, so what was handed out stays where it is
+    struct Array
+    {
+        std::shared_ptr<void> storage;
+        void*                 data    = nullptr;
+        size_t                size    = 0;
+        JsonType              element = JsonType::Int;
+    };
+
+    mutable std::mutex                                mutex;
+    mutable std::unordered_map<uint32_t, std::string> strings;
+    mutable std::unordered_map<uint32_t, Array>       arrays;
+
+    [[nodiscard]] char At(const uint32_t cursor) const { return json[index[cursor]]; }
+
+    [[noreturn]] static void Error(const std::string_view message, const size_t offset)
+    {
+        ThrowParseError(message, offset);
+    }
+
+    // Indexes the input and pairs up its brackets
+    void Build()
+    {
+        BuildStructuralIndex(json, index);
+        if (index.empty() || At(0) != '{')
+        {
+            Error("expected '{' at the start of the document", index.empty() ? 0 : index[0]);
+        }
+
+        match.assign(index.size(), 0);
+        std::vector<uint32_t> open;
+        for (uint32_t i = 0; i < index.size(); ++i)
+        {
+            const char c = At(i);
+            switch (c)
+            {
+            case '"': ++i; break; // Nothing inside a string is indexed, so the closing quote is the next entry
+            case '{':
+            case '[':
+                if (open.size() > MaxDepth)
+                {
+                    Error("document is nested too deeply", index[i]);
+                }
+                open.push_back(i);
+                break;
+            case '}':
+            case ']':
+                if (open.empty() || At(open.back()) != (c == '}' ? '{' : '['))
+                {
+                    Error(std::string("unexpected '") + c + "'", index[i]);
+                }
+                match[open.back()] = i;
+                open.pop_back();
+                if (open.empty() && i + 1 < index.size())
+                {
+                    Error("unexpected data after the root object", index[i + 1]);
+                }
+                break;
+            default: break;
+            }
+        }
+
+        if (!open.empty())
+        {
+            Error(At(open.back()) == '{' ? "unterminated object" : "unterminated array", json.size());
+        }
+    }
+
+    // The entry just past the value that starts at cursor
+    [[nodiscard]] uint32_t Skip(const uint32_t cursor) const
+    {
+        switch (At(cursor))
+        {
+        case '{':
+        case '[': return match[cursor] + 1;
+        case '"': return cursor + 2;
+        default: return cursor + 1;
+        }
+    }
+
+    // The number or literal at cursor, without any whitespace that follows it
+    [[nodiscard]] std::string_view Token(const uint32_t cursor) const
+    {
+        const size_t offset = index[cursor];
+        const size_t limit  = cursor + 1 < index.size() ? index[cursor + 1] : json.size();
+        return ScalarToken(json, offset, limit);
+    }
+
+    // A number, read the way Parse reads it: an int if it is written as one and fits, a double otherwise
+    [[nodiscard]] JsonValue Number(const uint32_t cursor) const
+    {
+        const JsonNumber number = ParseJsonNumber(Token(cursor), index[cursor]);
+        if (number.isInt)
+        {
+            return number.integer;
+        }
+        return number.value;
+    }
+
+    [[nodiscard]] JsonValue Scalar(const uint32_t cursor) const
+    {
+        const std::string_view token = Token(cursor);
+        if (token == "true")
+        {
+            return true;
+        }
+        if (token == "false")
+        {
+            return false;
+        }
+        if (token == "null")
+        {
+            return nullptr;
+        }
+        return Number(cursor);
+    }
+
+    // The string at cursor without its quotes, exactly as written
+    [[nodiscard]] std::string_view RawString(const uint32_t cursor) const
+    {
+        const uint32_t open = index[cursor];
+        return json.substr(open + 1, index[cursor + 1] - open - 1);
+    }
+
+    void Unescape(const uint32_t cursor, const std::string_view raw, std::string& out) const
+    {
+        try
+        {
+            WriteUnescaped(out, raw);
+        } catch (const std::runtime_error& e)
+        {
+            Error(e.what(), index[cursor]);
+        }
+    }
+
+    // The string at cursor, decoded. Strings with escapes are decoded once and kept
+    [[nodiscard]] std::string_view String(const uint32_t cursor) const
+    {
+        const std::string_view raw = RawString(cursor);
+        if (raw.find('\\') == std::string_view::npos)
+        {
+            return raw;
+        }
+
+        std::lock_guard lock(mutex);
+        auto [it, added] = strings.try_emplace(cursor);
+        if (added)
+        {
+            Unescape(cursor, raw, it->second);
+        }
+        return it->second;
+    }
+
+    // Calls visit(key, value) with the raw text of every key of the object opening at open and the entry its value
+    // starts at, until visit returns true. Checks the syntax of what it walks over
+    template<typename Visit>
+    void ForEachMember(const uint32_t open, Visit&& visit) const
+    {
+        const uint32_t close  = match[open];
+        uint32_t       cursor = open + 1;
+        if (cursor == close)
+        {
+            return;
+        }
+
+        while (true)
+        {
+            if (At(cursor) != '"')
+            {
+                Error("expected a key", index[cursor]);
+            }
+            const uint32_t key = cursor;
+            cursor += 2;
+
+            if (At(cursor) != ':')
+            {
+                Error("expected ':' after key", index[cursor]);
+            }
+            ++cursor;
+
+            const char c = At(cursor);
+            if (c == '}' || c == ']' || c == ':' || c == ',')
+            {
+                Error("expected a value", index[cursor]);
+            }
+            if (visit(key, cursor))
+            {
+                return;
+            }
+
+            cursor = Skip(cursor);
+            if (cursor == close)
+            {
+                return;
+            }
+            if (At(cursor) != ',')
+            {
+                Error("expected ',' or '}'", index[cursor]);
+            }
+            ++cursor;
+        }
+    }
+
+    // Parses the array opening at cursor following Parse's rules: the first element decides the type of all of them
+    [[nodiscard]] Array ParseArray(const uint32_t cursor) const
+    {
+        const uint32_t first = cursor + 1;
+        if (first == match[cursor])
+        {
+            return Own(std::vector<int>());
+        }
+
+        const ArrayKind kind = ArrayKindOf(At(first), index[first]);
+        switch (kind)
+        {
+        case ArrayKind::Strings:
+            return Own(Elements<std::string>(cursor, kind, [this](const uint32_t element) {
+                const std::string_view raw = RawString(element);
+                std::string            text;
+                if (raw.find('\\') == std::string_view::npos)
+                {
+                    text = raw;
+                } else
+                {
+                    Unescape(element, raw, text);
+                }
+                return text;
+            }));
+        case ArrayKind::Objects:
+            return Own(Elements<LazyObject>(cursor, kind,
+                                            [this](const uint32_t element) { return LazyObject(this, element); }));
+        case ArrayKind::Bools:
+            return Own(Elements<bool>(cursor, kind, [this](const uint32_t element) {
+                return ParseBoolElement(Token(element), index[element]);
+            }));
+        default: break;
+        }
+
+        NumberElements numbers;
+        ForEachElement(cursor, kind, [this, &numbers](const uint32_t element) {
+            numbers.Add(Token(element), index[element]);
+        });
+
+        if (numbers.allInt)
+        {
+            return Own(numbers.Integers());
+        }
+        return Own(std::move(numbers.values));
+    }
+
+    // Calls visit with every element of the array opening at cursor, each of which has to belong in an array of kind
+    template<typename Visit>
+    void ForEachElement(const uint32_t cursor, const ArrayKind kind, Visit&& visit) const
+    {
+        const uint32_t close = match[cursor];
+        for (uint32_t element = cursor + 1;;)
+        {
+            CheckArrayElement(kind, At(element), index[element]);
+            visit(element);
+
+            element = Skip(element);
+            if (element == close)
+            {
+                return;
+            }
+            if (At(element) != ',')
+            {
+                Error("expected ',' or ']'", index[element]);
+            }
+            ++element;
+        }
+    }
+
+    template<typename T, typename Parse>
+    [[nodiscard]] std::vector<T> Elements(const uint32_t cursor, const ArrayKind kind, Parse&& parse) const
+    {
+        std::vector<T> values;
+        ForEachElement(cursor, kind, [&values, &parse](const uint32_t element) { values.push_back(parse(element)); });
+        return values;
+    }
+
+    template<typename T>
+    [[nodiscard]] static Array Own(std::vector<T>&& values)
+    {
+        Array array;
+        array.size    = values.size();
+        array.element = TypeOf<LazyStored<T>>;
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            // std::vector<bool> packs its bits, so it can't be viewed as a span
+            std::shared_ptr<bool[]> storage(new bool[values.size()]);
+            std::copy(values.begin(), values.end(), storage.get());
+            array.data    = storage.get();
+            array.storage = std::move(storage);
+        } else
+        {
+            auto storage  = std::make_shared<std::vector<T>>(std::move(values));
+            array.data    = storage->data();
+            array.storage = std::move(storage);
+        }
+        return array;
+    }
+
+    // Parses the array opening at cursor on first use
+    [[nodiscard]] const Array& GetArray(const uint32_t cursor) const
+    {
+        std::lock_guard lock(mutex);
+        auto            it = arrays.find(cursor);
+        if (it == arrays.end())
+        {
+            it = arrays.emplace(cursor, ParseArray(cursor)).first;
+        }
+        return it->second;
+    }
+};
+
+namespace
+{
+
+// Whether the raw text of a key, escapes and all, decodes to key
+bool KeyMatches(const LazyState& state, const uint32_t cursor, const std::string_view key, std::string& decoded)
+{
+    const std::string_view raw = state.RawString(cursor);
+    if (raw.size() == key.size())
+    {
+        // Escapes only ever make a key longer than what they decode to
+        return raw == key && raw.find('\\') == std::string_view::npos;
+    }
+    if (raw.size() < key.size() || raw.find('\\') == std::string_view::npos)
+    {
+        return false;
+    }
+
+    decoded.clear();
+    state.Unescape(cursor, raw, decoded);
+    return decoded == key;
+}
+
+} // namespace
+
+} // namespace detail
+
+uint32_t LazyObject::Find(const std::string_view key) const
+{
+    uint32_t    found = NotFound;
+    std::string decoded;
+    mState->ForEachMember(mOpen, [&](const uint32_t name, const uint32_t value) {
+        if (detail::KeyMatches(*mState, name, key, decoded))
+        {
+            found = value;
+            return true;
+        }
+        return false;
+    });
+    return found;
+}
+
+uint32_t LazyObject::Locate(const std::string_view key) const
+{
+    const uint32_t cursor = Find(key);
+    if (cursor == NotFound)
+    {
+        JsonObject::ThrowKeyNotFound(key);
+    }
+    return cursor;
+}
+
+bool LazyObject::Contains(const std::string_view key) const
+{
+    return Find(key) != NotFound;
+}
+
+size_t LazyObject::Size() const
+{
+    size_t count = 0;
+    mState->ForEachMember(mOpen, [&count](uint32_t, uint32_t) {
+        ++count;
+        return false;
+    });
+    return count;
+}
+
+std::string_view LazyObject::Raw() const
+{
+    const uint32_t open = mState->index[mOpen];
+    return mState->json.substr(open, mState->index[mState->match[mOpen]] - open + 1);
+}
+
+JsonObject LazyObject::Materialize(std::pmr::memory_resource* resource) const
+{
+    return JsonObject::Parse(Raw(), resource);
+}
+
+bool LazyObject::IsObject(const uint32_t cursor) const
+{
+    return mState->At(cursor) == '{';
+}
+
+bool LazyObject::ReadScalar(const uint32_t cursor, JsonValue& value) const
+{
+    switch (mState->At(cursor))
+    {
+    case '{':
+    case '[': return false;
+    case '"': value.AssignView(mState->String(cursor)); return true;
+    default: value = mState->Scalar(cursor); return true;
+    }
+}
+
+bool LazyObject::ReadArray(const uint32_t cursor, const JsonType element, void*& data, size_t& size) const
+{
+    if (mState->At(cursor) != '[')
+    {
+        return false;
+    }
+
+    const detail::LazyState::Array& array = mState->GetArray(cursor);
+    if (array.element != element)
+    {
+        return false;
+    }
+    data = array.data;
+    size = array.size;
+    return true;
+}
+
+void LazyObject::ThrowTypeMismatch(const uint32_t cursor, const std::string& expectedType, const std::string_view key) const
+{
+    // Whatever Parse would have stored, so the message reads the same as JsonObject's
+    JsonValue stored;
+    switch (mState->At(cursor))
+    {
+    case '{': stored = std::shared_ptr<JsonObject>(); break;
+    case '"': stored = std::string(); break;
+    case '[':
+        switch (mState->GetArray(cursor).element)
+        {
+        case JsonType::Bool: stored = std::span<bool>(); break;
+        case JsonType::Double: stored = std::span<double>(); break;
+        case JsonType::String: stored = std::span<std::string>(); break;
+        case JsonType::Object: stored = std::span<std::shared_ptr<JsonObject>>(); break;
+        default: stored = std::span<int>(); break;
+        }
+        break;
+    default: stored = mState->Scalar(cursor); break;
+    }
+    stored.ThrowTypeMismatch(expectedType, key);
+}
+
+LazyDocument::LazyDocument(std::unique_ptr<detail::LazyState> state) : LazyObject(state.get(), 0), mOwned(std::move(state))
+{}
+
+LazyDocument::~LazyDocument() = default;
+
+LazyDocument::LazyDocument(LazyDocument&& other) noexcept : LazyObject(other), mOwned(std::move(other.mOwned))
+{
+    static_cast<LazyObject&>(other) = LazyObject();
+}
+
+LazyDocument& LazyDocument::operator=(LazyDocument&& other) noexcept
+{
+    if (this != &other)
+    {
+        LazyObject::operator=(other);
+        mOwned                          = std::move(other.mOwned);
+        static_cast<LazyObject&>(other) = LazyObject();
+    }
+    return *this;
+}
+
+LazyDocument LazyDocument::Parse(const std::string_view json)
+{
+    auto state   = std::make_unique<detail::LazyState>();
+    state->owned = json;
+    state->json  = state->owned;
+    state->Build();
+    return LazyDocument(std::move(state));
+}
+
+LazyDocument LazyDocument::View(const std::string_view json)
+{
+    auto state  = std::make_unique<detail::LazyState>();
+    state->json = json;
+    state->Build();
+    return LazyDocument(std::move(state));
+}
+
+LazyDocument LazyDocument::ParseFile(const std::string_view filename)
+{
+    std::ifstream fs(std::string(filename), std::ios::binary | std::ios::ate);
+    if (!fs.is_open())
+    {
+        throw std::runtime_error("Failed to open file for reading");
+    }
+
+    auto state = std::make_unique<detail::LazyState>();
+    state->owned.resize(static_cast<size_t>(fs.tellg()));
+    fs.seekg(0);
+    fs.read(state->owned.data(), static_cast<std::streamsize>(state->owned.size()));
+    state->json = state->owned;
+    state->Build();
+    return LazyDocument(std::move(state));
+}
+
+LazyDocument LazyDocument::MapFile(const std::string_view filename)
+{
+    auto state       = std::make_unique<detail::LazyState>();
+    auto file        = std::make_shared<detail::MappedFile>(filename);
+    state->json      = file->View();
+    state->keepAlive = std::move(file);
+    state->Build();
+    return LazyDocument(std::move(state));
+}
+
+} // namespace cereal
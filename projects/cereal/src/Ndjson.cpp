@@ -0,0 +1,347 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Ndjson.cpp
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "Ndjson.h"
+#include "FileIo.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace cereal
+{
+
+namespace
+{
+
+// Chunks per pool thread in each window the reader parses
+constexpr size_t ChunksPerThread = 4;
+
+} // namespace
+
+namespace detail
+{
+
+// Durations below SubBuckets nanoseconds get a bucket each. Above that, every power of two is split into SubBuckets
+// linear steps, indexed by the top bits of the value
+void LatencyHistogram::Record(const std::chrono::nanoseconds duration)
+{
+    const uint64_t nanoseconds = static_cast<uint64_t>((std::max)(duration.count(), int64_t(0)));
+
+    size_t index = nanoseconds;
+    if (nanoseconds >= SubBuckets)
+    {
+        const int shift = std::bit_width(nanoseconds) - std::bit_width(SubBuckets);
+        index           = static_cast<size_t>(shift) * SubBuckets + static_cast<size_t>(nanoseconds >> shift);
+    }
+    ++mBuckets[(std::min)(index, mBuckets.size() - 1)];
+    ++mCount;
+}
+
+double LatencyHistogram::Percentile(const double fraction) const
+{
+    if (mCount == 0)
+    {
+        return 0.0;
+    }
+
+    const uint64_t target = (std::max)(uint64_t(1), static_cast<uint64_t>(fraction * static_cast<double>(mCount) + 0.5));
+
+    uint64_t seen = 0;
+    for (size_t index = 0; index < mBuckets.size(); ++index)
+    {
+        seen += mBuckets[index];
+        if (seen >= target)
+        {
+            // Invert Record for the largest value that lands in this bucket
+            const size_t   shift = index < SubBuckets ? 0 : index / SubBuckets - 1;
+            const uint64_t top   = index < SubBuckets ? index : index - shift * SubBuckets;
+            const uint64_t upper = ((top + 1) << shift) - 1;
+            return static_cast<double>(upper) * 1e-9;
+        }
+    }
+    return 0.0;
+}
+
+} // namespace detail
+
+NdjsonWriter::NdjsonWriter(const int descriptor, ThreadPool& pool, const size_t batchRecords, const size_t maxBatches) :
+    mPool(pool), mBatchRecords((std::max)(batchRecords, size_t(1))),
+    mOutput(std::make_unique<detail::FileOutput>(descriptor))
+{
+    Start(maxBatches);
+}
+
+NdjsonWriter::NdjsonWriter(const std::string_view filename, ThreadPool& pool, const size_t batchRecords,
+                           const size_t maxBatches) :
+    mPool(pool), mBatchRecords((std::max)(batchRecords, size_t(1))), mOutput(std::make_unique<detail::FileOutput>(filename))
+{
+    Start(maxBatches);
+}
+
+NdjsonWriter::~NdjsonWriter()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mStop = true;
+    }
+    mQueued.notify_one();
+    mThread.join();
+}
+
+void NdjsonWriter::Start(const size_t maxBatches)
+{
+    const size_t count = maxBatches > 0 ? maxBatches : size_t(2) * mPool.Size();
+
+    mBatches.reserve(count);
+    mFree.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        mBatches.push_back(std::make_unique<Batch>());
+        mFree.push_back(mBatches.back().get());
+    }
+    // Handed out from the back, so the first batches go out in the order they were made
+    std::reverse(mFree.begin(), mFree.end());
+
+    mThread = std::thread([this] { OutputLoop(); });
+}
+
+const std::vector<NdjsonWriter::Batch*>& NdjsonWriter::Acquire(const size_t wanted)
+{
+    std::unique_lock lock(mMutex);
+    mReturned.wait(lock, [this] { return !mFree.empty() || mError; });
+    if (mError)
+    {
+        std::rethrow_exception(mError);
+    }
+
+    if (!mStarted)
+    {
+        mFirstWrite = Clock::now();
+        mStarted    = true;
+    }
+
+    mAcquired.clear();
+    while (mAcquired.size() < wanted && !mFree.empty())
+    {
+        mAcquired.push_back(mFree.back());
+        mFree.pop_back();
+    }
+    return mAcquired;
+}
+
+void NdjsonWriter::Submit()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mQueue.insert(mQueue.end(), mAcquired.begin(), mAcquired.end());
+    }
+    mAcquired.clear();
+    mQueued.notify_one();
+}
+
+void NdjsonWriter::Release()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mFree.insert(mFree.end(), mAcquired.begin(), mAcquired.end());
+    }
+    mAcquired.clear();
+    mReturned.notify_all();
+}
+
+void NdjsonWriter::Flush()
+{
+    std::unique_lock lock(mMutex);
+    mReturned.wait(lock, [this] { return mFree.size() == mBatches.size(); });
+    if (mError)
+    {
+        std::rethrow_exception(mError);
+    }
+}
+
+NdjsonStats NdjsonWriter::GetStats() const
+{
+    std::lock_guard lock(mMutex);
+
+    NdjsonStats stats     = mStats;
+    stats.p50BatchSeconds = mLatency.Percentile(0.50);
+    stats.p99BatchSeconds = mLatency.Percentile(0.99);
+    return stats;
+}
+
+void NdjsonWriter::OutputLoop()
+{
+    std::unique_lock lock(mMutex);
+    while (true)
+    {
+        mQueued.wait(lock, [this] { return mStop || !mQueue.empty(); });
+        if (mQueue.empty())
+        {
+            return;
+        }
+
+        Batch* batch = mQueue.front();
+        mQueue.pop_front();
+
+        // Once a write has failed the rest are dropped, there is no telling what made it out
+        const bool skip = mError != nullptr;
+        lock.unlock();
+
+        const auto size    = static_cast<std::streamsize>(batch->text.size());
+        const bool written = skip || mOutput->sputn(batch->text.data(), size) == size;
+        const auto now     = Clock::now();
+
+        lock.lock();
+        if (!written && !mError)
+        {
+            mError = std::make_exception_ptr(std::runtime_error("Failed to write file"));
+        }
+        if (!skip && written)
+        {
+            mStats.records += batch->records;
+            mStats.bytes += batch->text.size();
+            ++mStats.batches;
+            mStats.seconds = std::chrono::duration<double>(now - mFirstWrite).count();
+            mLatency.Record(now - batch->start);
+        }
+        mFree.push_back(batch);
+        mReturned.notify_all();
+    }
+}
+
+size_t NdjsonReader::LineStart(const std::string_view ndjson, const size_t start, const size_t offset)
+{
+    if (offset <= start)
+    {
+        return start;
+    }
+    if (offset >= ndjson.size())
+    {
+        return ndjson.size();
+    }
+
+    // offset itself starts a line if the byte before it ends one
+    const void* newline = std::memchr(ndjson.data() + offset - 1, '\n', ndjson.size() - (offset - 1));
+    return newline ? static_cast<size_t>(static_cast<const char*>(newline) - ndjson.data()) + 1 : ndjson.size();
+}
+
+void NdjsonReader::ParseChunk(std::string_view text, Chunk& chunk)
+{
+    chunk.records.clear();
+    chunk.lines     = 0;
+    chunk.errorLine = 0;
+    chunk.error.clear();
+
+    while (!text.empty())
+    {
+        const size_t     end  = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text                  = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+        ++chunk.lines;
+
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        if (line.find_first_not_of(" \t") == std::string_view::npos)
+        {
+            continue;
+        }
+
+        try
+        {
+            chunk.records.push_back(JsonObject::Parse(line));
+        } catch (const std::exception& e)
+        {
+            chunk.errorLine = chunk.lines;
+            chunk.error     = e.what();
+            return;
+        }
+    }
+}
+
+void NdjsonReader::Read(const std::string_view ndjson, const Handler& handler)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const size_t chunkSize = (std::max)(mChunkSize, size_t(1));
+    mChunks.resize(mPool.Size() * ChunksPerThread);
+
+    size_t lines = 0;
+    for (size_t start = 0; start < ndjson.size();)
+    {
+        const auto   windowStart = Clock::now();
+        const size_t end         = LineStart(ndjson, start, start + mChunks.size() * chunkSize);
+
+        // Each chunk finds its own first line, so the cuts are made in parallel too. A line longer than a chunk simply
+        // leaves the chunks it covers empty
+        mPool.ForEach(mChunks.size(), [&](const size_t i) {
+            const size_t first = (std::min)(LineStart(ndjson, start, start + i * chunkSize), end);
+            const size_t last  = (std::min)(LineStart(ndjson, start, start + (i + 1) * chunkSize), end);
+            ParseChunk(ndjson.substr(first, last - first), mChunks[i]);
+        });
+
+        for (Chunk& chunk : mChunks)
+        {
+            for (JsonObject& record : chunk.records)
+            {
+                handler(record);
+            }
+            mStats.records += chunk.records.size();
+
+            if (chunk.errorLine != 0)
+            {
+                throw std::runtime_error("Ndjson parse error on line " + std::to_string(lines + chunk.errorLine) + ": " +
+                                         chunk.error);
+            }
+            lines += chunk.lines;
+        }
+
+        const auto elapsed = Clock::now() - windowStart;
+        mStats.bytes += end - start;
+        ++mStats.batches;
+        mStats.seconds += std::chrono::duration<double>(elapsed).count();
+        mLatency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+
+        start = end;
+    }
+}
+
+void NdjsonReader::ReadFile(const std::string_view filename, const Handler& handler)
+{
+    const detail::MappedFile file(filename);
+    Read(file.View(), handler);
+}
+
+NdjsonStats NdjsonReader::GetStats() const
+{
+    NdjsonStats stats     = mStats;
+    stats.p50BatchSeconds = mLatency.Percentile(0.50);
+    stats.p99BatchSeconds = mLatency.Percentile(0.99);
+    return stats;
+}
+
+} // namespace cereal
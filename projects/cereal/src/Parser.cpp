@@ -0,0 +1,413 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Parser
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#include "Json.h"
+#include "Escape.h"
+#include "StructuralIndex.h"
+#include "Grammar.h"
+#include "FileIo.h"
+
+#include <fstream>
+#include <memory_resource>
+
+namespace cereal
+{
+
+namespace detail
+{
+
+// Second stage of parsing. Walks the structural index and builds the JsonObject tree, only touching the bytes of
+// strings and numbers when it needs their values
+class JsonParser
+{
+public:
+    // When keepAlive is set, json is owned by it and keys and strings are viewed rather than copied, the ones with
+    // escapes from a decoded copy allocated from escaped, which keepAlive has to own too. Every object parsed then
+    // holds on to keepAlive
+    JsonParser(const std::string_view json, std::pmr::memory_resource* resource, std::shared_ptr<void> keepAlive = {},
+               std::pmr::memory_resource* escaped = nullptr) :
+        mJson(json), mResource(resource), mEscaped(escaped), mKeepAlive(std::move(keepAlive))
+    {
+        CEREAL_INSTRUMENT_PHASE(Phase::Index);
+        BuildStructuralIndex(json, mIndex);
+    }
+
+    JsonObject ParseDocument()
+    {
+        CEREAL_INSTRUMENT_PHASE(Phase::Build);
+
+        JsonObject root(mResource);
+        if (AtEnd() || Peek() != '{')
+        {
+            Error("expected '{' at the start of the document", AtEnd() ? 0 : mIndex[mCursor]);
+        }
+
+        ParseObject(root, 0);
+
+        if (!AtEnd())
+        {
+            Error("unexpected data after the root object", mIndex[mCursor]);
+        }
+        return root;
+    }
+
+private:
+    static constexpr int MaxDepth = 1024;
+
+    [[nodiscard]] bool AtEnd() const { return mCursor >= mIndex.size(); }
+    [[nodiscard]] char Peek() const { return mJson[mIndex[mCursor]]; }
+
+    [[noreturn]] static void Error(const std::string_view message, const size_t offset)
+    {
+        ThrowParseError(message, offset);
+    }
+
+    void ExpectMore(const std::string_view message) const
+    {
+        if (AtEnd())
+        {
+            Error(message, mJson.size());
+        }
+    }
+
+    // Consumes the next structural character, which has to be one of the two given
+    char NextSeparator(const char continueWith, const char endWith)
+    {
+        ExpectMore("unexpected end of document");
+        const uint32_t pos = mIndex[mCursor++];
+        const char     c   = mJson[pos];
+        if (c != continueWith && c != endWith)
+        {
+            Error(std::string("expected '") + continueWith + "' or '" + endWith + "'", pos);
+        }
+        return c;
+    }
+
+    void ParseObject(JsonObject& obj, const int depth)
+    {
+        if (depth > MaxDepth)
+        {
+            Error("document is nested too deeply", mIndex[mCursor]);
+        }
+
+        if (mKeepAlive)
+        {
+            obj.mOwnedArrays.push_back(mKeepAlive);
+        }
+
+        ++mCursor; // '{'
+        ExpectMore("unterminated object");
+        if (Peek() == '}')
+        {
+            ++mCursor;
+            return;
+        }
+
+        do
+        {
+            ExpectMore("unterminated object");
+            if (Peek() != '"')
+            {
+                Error("expected a key", mIndex[mCursor]);
+            }
+            const std::string_view key = ParseStringView();
+
+            ExpectMore("unterminated object");
+            if (Peek() != ':')
+            {
+                Error("expected ':' after key", mIndex[mCursor]);
+            }
+            ++mCursor;
+
+            ParseValue(obj, mKeepAlive ? obj.ViewSlot(Viewable(key)) : obj.Slot(key), depth);
+        } while (NextSeparator(',', '}') == ',');
+    }
+
+    void ParseValue(JsonObject& owner, JsonObject::JsonValue& slot, const int depth)
+    {
+        CEREAL_INSTRUMENT_NODES(1);
+        ExpectMore("expected a value");
+
+        const uint32_t pos = mIndex[mCursor];
+        switch (mJson[pos])
+        {
+        case '"':
+        {
+            const std::string_view text = ParseStringView();
+            if (mKeepAlive && text.size() <= UINT32_MAX)
+            {
+                slot.AssignView(Viewable(text));
+            } else
+            {
+                slot.Assign(text, mResource);
+            }
+            return;
+        }
+        case '{':
+        {
+            auto child = owner.CreateObject();
+            ParseObject(*child, depth + 1);
+            slot.Assign(std::move(child), mResource);
+            return;
+        }
+        case '[': slot = ParseArray(owner, depth + 1); return;
+        case '}':
+        case ']':
+        case ':':
+        case ',': Error("expected a value", pos);
+        default: slot = ParseScalar(); return;
+        }
+    }
+
+    std::string ParseString() { return std::string(ParseStringView()); }
+
+    // The last string parsed, somewhere that lives as long as keepAlive. Only strings that had escapes need copying
+    std::string_view Viewable(const std::string_view text)
+    {
+        if (!mInScratch)
+        {
+            return text;
+        }
+
+        char* copy = static_cast<char*>(mEscaped->allocate(text.size(), alignof(char)));
+        text.copy(copy, text.size());
+        return { copy, text.size() };
+    }
+
+    // Points straight into the input unless the string had escapes, in which case it points at the decoded copy in
+    // mScratch and is only valid until the next string is parsed
+    std::string_view ParseStringView()
+    {
+        // Nothing inside a string is indexed, so the closing quote is always the very next entry. Stage one already
+        // rejected unterminated strings
+        const uint32_t open  = mIndex[mCursor];
+        const uint32_t close = mIndex[mCursor + 1];
+        mCursor += 2;
+
+        const std::string_view raw = mJson.substr(open + 1, close - open - 1);
+        mInScratch                 = raw.find('\\') != std::string_view::npos;
+        if (!mInScratch)
+        {
+            return raw;
+        }
+
+        mScratch.clear();
+        try
+        {
+            WriteUnescaped(mScratch, raw);
+        } catch (const std::runtime_error& e)
+        {
+            Error(e.what(), open);
+        }
+        return mScratch;
+    }
+
+    // Returns the next number or literal token, without any whitespace that follows it
+    std::string_view NextToken(uint32_t& offset)
+    {
+        offset             = mIndex[mCursor];
+        const size_t limit = mCursor + 1 < mIndex.size() ? mIndex[mCursor + 1] : mJson.size();
+        ++mCursor;
+        return ScalarToken(mJson, offset, limit);
+    }
+
+    JsonObject::JsonValue ParseScalar()
+    {
+        uint32_t               offset = 0;
+        const std::string_view token  = NextToken(offset);
+        if (token == "true")
+        {
+            return true;
+        }
+        if (token == "false")
+        {
+            return false;
+        }
+        if (token == "null")
+        {
+            return nullptr;
+        }
+
+        const JsonNumber number = ParseJsonNumber(token, offset);
+        if (number.isInt)
+        {
+            return number.integer;
+        }
+        return number.value;
+    }
+
+    bool ParseBool()
+    {
+        uint32_t               offset = 0;
+        const std::string_view token  = NextToken(offset);
+        return ParseBoolElement(token, offset);
+    }
+
+    // Arrays have to hold a single type, so the first element decides what every other element is parsed as and the
+    // values go straight into the array's storage
+    JsonObject::JsonValue ParseArray(JsonObject& owner, const int depth)
+    {
+        const uint32_t open = mIndex[mCursor++];
+        if (depth > MaxDepth)
+        {
+            Error("document is nested too deeply", open);
+        }
+
+        ExpectMore("unterminated array");
+        if (Peek() == ']')
+        {
+            ++mCursor;
+            return std::span<int>();
+        }
+
+        const ArrayKind kind = ArrayKindOf(Peek(), mIndex[mCursor]);
+        switch (kind)
+        {
+        case ArrayKind::Strings: return Own(owner, ParseElements<std::string>(kind, [this] { return ParseString(); }));
+        case ArrayKind::Objects:
+            return Own(owner, ParseElements<std::shared_ptr<JsonObject>>(kind, [this, &owner, depth] {
+                           auto child = owner.CreateObject();
+                           ParseObject(*child, depth + 1);
+                           return child;
+                       }));
+        case ArrayKind::Bools: return Own(owner, ParseElements<bool>(kind, [this] { return ParseBool(); }));
+        default: break;
+        }
+
+        NumberElements numbers;
+        ForEachElement(kind, [this, &numbers] {
+            uint32_t               offset = 0;
+            const std::string_view token  = NextToken(offset);
+            numbers.Add(token, offset);
+        });
+        CEREAL_INSTRUMENT_NODES(numbers.values.size());
+
+        if (numbers.allInt)
+        {
+            return Own(owner, numbers.Integers());
+        }
+        return Own(owner, std::move(numbers.values));
+    }
+
+    // Calls parseElement for each comma separated element up to the closing ']', every one of which has to belong in an
+    // array of kind
+    template<typename Fn>
+    void ForEachElement(const ArrayKind kind, Fn&& parseElement)
+    {
+        do
+        {
+            ExpectMore("unterminated array");
+            CheckArrayElement(kind, Peek(), mIndex[mCursor]);
+            parseElement();
+        } while (NextSeparator(',', ']') == ',');
+    }
+
+    template<typename T, typename Fn>
+    std::vector<T> ParseElements(const ArrayKind kind, Fn&& parseElement)
+    {
+        std::vector<T> values;
+        ForEachElement(kind, [&values, &parseElement] { values.push_back(parseElement()); });
+        CEREAL_INSTRUMENT_NODES(values.size());
+        return values;
+    }
+
+    template<typename T>
+    static std::span<T> Own(JsonObject& owner, std::vector<T>&& values)
+    {
+        std::shared_ptr<T[]> storage =
+            std::allocate_shared<T[]>(std::pmr::polymorphic_allocator<T>(owner.GetResource()), values.size());
+        CEREAL_INSTRUMENT_ALLOCATION(values.size() * sizeof(T));
+        std::move(values.begin(), values.end(), storage.get());
+
+        std::span<T> span(storage.get(), values.size());
+        owner.mOwnedArrays.push_back(std::move(storage));
+        return span;
+    }
+
+private:
+    std::string_view           mJson;
+    std::pmr::memory_resource* mResource;
+    std::pmr::memory_resource* mEscaped;
+    std::vector<uint32_t>      mIndex;
+    size_t                     mCursor = 0;
+    std::string                mScratch;
+    bool                       mInScratch = false; // Whether the last string parsed is in mScratch
+    std::shared_ptr<void>      mKeepAlive;
+};
+
+// What every object read by MapFile holds on to: the mapping, and the decoded copies of strings that had escapes so
+// those are viewed just like the rest
+struct MappedDocument
+{
+    MappedDocument(const std::string_view filename, std::pmr::memory_resource* resource) :
+        file(filename), escaped(resource)
+    {
+    }
+
+    MappedFile                          file;
+    std::pmr::monotonic_buffer_resource escaped;
+};
+
+} // namespace detail
+
+JsonObject JsonObject::Parse(const std::string_view json, std::pmr::memory_resource* resource)
+{
+    CEREAL_INSTRUMENT_OPERATION(Operation::Parse, Phase::Build);
+    CEREAL_INSTRUMENT_RESULT(json.size());
+
+    detail::JsonParser parser(json, resource);
+    return parser.ParseDocument();
+}
+
+JsonObject JsonObject::ParseFile(const std::string_view filename, std::pmr::memory_resource* resource)
+{
+    CEREAL_INSTRUMENT_OPERATION(Operation::ParseFile, Phase::Read);
+
+    std::ifstream fs(std::string(filename), std::ios::binary | std::ios::ate);
+
+    if (!fs.is_open())
+    {
+        throw std::runtime_error("Failed to open file for reading");
+    }
+
+    std::string json(static_cast<size_t>(fs.tellg()), '\0');
+    fs.seekg(0);
+    fs.read(json.data(), static_cast<std::streamsize>(json.size()));
+    CEREAL_INSTRUMENT_RESULT(json.size());
+
+    return Parse(json, resource);
+}
+
+JsonObject JsonObject::MapFile(const std::string_view filename, std::pmr::memory_resource* resource)
+{
+    CEREAL_INSTRUMENT_OPERATION(Operation::MapFile, Phase::Read);
+
+    auto document = std::allocate_shared<detail::MappedDocument>(
+        std::pmr::polymorphic_allocator<detail::MappedDocument>(resource), filename, resource);
+    CEREAL_INSTRUMENT_RESULT(document->file.View().size());
+
+    detail::JsonParser parser(document->file.View(), resource, document, &document->escaped);
+    return parser.ParseDocument();
+}
+
+} // namespace cereal
@@ -0,0 +1,318 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Pointer.cpp
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "Pointer.h"
+
+namespace cereal
+{
+
+namespace
+{
+
+// "0" or digits that don't start with a zero, as RFC 6901 spells array indices. Anything else can only be a key
+size_t ParseIndex(const std::string_view token)
+{
+    if (token.empty() || token.size() > 18 || (token.size() > 1 && token[0] == '0'))
+    {
+        return JsonPointer::NotAnIndex;
+    }
+
+    size_t index = 0;
+    for (const char c : token)
+    {
+        if (c < '0' || c > '9')
+        {
+            return JsonPointer::NotAnIndex;
+        }
+        index = index * 10 + static_cast<size_t>(c - '0');
+    }
+    return index;
+}
+
+} // namespace
+
+JsonPointer::JsonPointer(const std::string_view pointer) : mText(pointer)
+{
+    if (pointer.empty())
+    {
+        return;
+    }
+    if (pointer[0] != '/')
+    {
+        throw std::runtime_error("Invalid JSON pointer, it has to start with '/': " + mText);
+    }
+
+    for (size_t pos = 1;;)
+    {
+        Entry& token = mTokens.emplace_back();
+        for (; pos < pointer.size() && pointer[pos] != '/'; ++pos)
+        {
+            if (pointer[pos] != '~')
+            {
+                token.text += pointer[pos];
+                continue;
+            }
+
+            const char escaped = pos + 1 < pointer.size() ? pointer[pos + 1] : '\0';
+            if (escaped != '0' && escaped != '1')
+            {
+                throw std::runtime_error("Invalid JSON pointer, '~' has to be followed by '0' or '1': " + mText);
+            }
+            token.text += escaped == '0' ? '~' : '/';
+            ++pos;
+        }
+
+        token.hash  = detail::HashKey(token.text);
+        token.index = ParseIndex(token.text);
+        token.end   = pos;
+        if (pos == pointer.size())
+        {
+            break;
+        }
+        ++pos;
+    }
+}
+
+JsonTarget JsonPointer::Step(const Container& container, const Entry& token)
+{
+    if (container.object)
+    {
+        const ValueMap& values = container.object->GetValues();
+        const auto      it     = values.find(HashedKey(token.text, token.hash));
+        if (it == values.end())
+        {
+            return {};
+        }
+        return { container.object, const_cast<JsonValue*>(&it->second), JsonTarget::WholeValue };
+    }
+
+    if (token.index >= container.array->ElementCount())
+    {
+        return {};
+    }
+    return { container.owner, container.array, token.index };
+}
+
+JsonPointer::Container JsonPointer::Enter(const JsonTarget& target)
+{
+    const JsonValue& value = *target.mValue;
+    if (target.mElement == JsonTarget::WholeValue)
+    {
+        switch (value.GetType())
+        {
+        case JsonType::Object:
+            return { value.Get<std::shared_ptr<JsonObject>>().get(), nullptr, nullptr };
+        case JsonType::InlineObject:
+            return { const_cast<JsonObject*>(&value.Get<JsonObject>()), nullptr, nullptr };
+        case JsonType::Span:
+        case JsonType::Array:
+            return { nullptr, target.mValue, target.mOwner };
+        default:
+            return {};
+        }
+    }
+
+    if (value.Holds<std::span<std::shared_ptr<JsonObject>>>())
+    {
+        return { value.Get<std::span<std::shared_ptr<JsonObject>>>()[target.mElement].get(), nullptr, nullptr };
+    }
+    if (value.Holds<std::span<JsonObject>>())
+    {
+        return { &value.Get<std::span<JsonObject>>()[target.mElement], nullptr, nullptr };
+    }
+    return {};
+}
+
+size_t JsonPointer::Walk(const JsonObject& root, JsonTarget& target) const
+{
+    // Step and Enter folded into one loop, since this is what every Get runs
+    JsonObject* object = const_cast<JsonObject*>(&root);
+    JsonValue*  array  = nullptr;
+    JsonObject* owner  = nullptr;
+    target             = {};
+    for (size_t i = 0; i < mTokens.size(); ++i)
+    {
+        const Entry& token   = mTokens[i];
+        JsonValue*   value   = array;
+        size_t       element = token.index;
+        if (object)
+        {
+            const ValueMap& values = object->GetValues();
+            const auto      it     = values.find(HashedKey(token.text, token.hash));
+            if (it == values.end())
+            {
+                return i;
+            }
+            owner   = object;
+            value   = const_cast<JsonValue*>(&it->second);
+            element = JsonTarget::WholeValue;
+        } else if (element >= array->ElementCount())
+        {
+            return i;
+        }
+
+        if (i + 1 == mTokens.size())
+        {
+            target = { owner, value, element };
+            break;
+        }
+
+        if (element == JsonTarget::WholeValue && value->GetType() == JsonType::Object)
+        {
+            object = value->Get<std::shared_ptr<JsonObject>>().get();
+            if (!object)
+            {
+                return i + 1;
+            }
+            continue;
+        }
+
+        const Container container = Enter({ owner, value, element });
+        object                    = container.object;
+        array                     = container.array;
+        if (!object && !array)
+        {
+            return i + 1;
+        }
+    }
+    return mTokens.size();
+}
+
+JsonTarget JsonPointer::Resolve(const JsonObject& root) const
+{
+    JsonTarget target;
+    Walk(root, target);
+    return target;
+}
+
+JsonPointer::Container JsonPointer::Parent(JsonObject& root) const
+{
+    if (mTokens.empty())
+    {
+        throw std::runtime_error("The empty JSON pointer refers to the whole document, which can't be set");
+    }
+
+    Container container{ &root, nullptr, nullptr };
+    for (size_t i = 0; i + 1 < mTokens.size(); ++i)
+    {
+        const JsonTarget target = Step(container, mTokens[i]);
+        if (target)
+        {
+            container = Enter(target);
+        }
+        if (!target || (!container.object && !container.array))
+        {
+            ThrowNotFound(root);
+        }
+    }
+    return container;
+}
+
+void JsonPointer::ThrowNotFound(const JsonObject& root) const
+{
+    JsonTarget target;
+    ThrowNotFound(Walk(root, target));
+}
+
+void JsonPointer::ThrowNotFound(const size_t found) const
+{
+    if (found == 0)
+    {
+        throw std::runtime_error("JSON pointer not found: " + mText);
+    }
+    throw std::runtime_error("JSON pointer " + mText + " leads nowhere past " + std::string(Prefix(found)));
+}
+
+JsonPointerSet::JsonPointerSet() : mNodes(1) {}
+
+size_t JsonPointerSet::Add(const JsonPointer& pointer)
+{
+    uint32_t node = 0;
+    for (const JsonPointer::Entry& token : pointer.mTokens)
+    {
+        uint32_t next = 0;
+        for (const uint32_t child : mNodes[node].children)
+        {
+            if (mNodes[child].token.text == token.text)
+            {
+                next = child;
+                break;
+            }
+        }
+
+        if (next == 0)
+        {
+            next = static_cast<uint32_t>(mNodes.size());
+            mNodes.push_back({ token, {}, {} });
+            mNodes[node].children.push_back(next);
+        }
+        node = next;
+    }
+
+    mNodes[node].pointers.push_back(static_cast<uint32_t>(mCount));
+    return mCount++;
+}
+
+void JsonPointerSet::Resolve(const JsonObject& root, std::vector<JsonTarget>& targets) const
+{
+    targets.assign(mCount, JsonTarget());
+    Resolve(mNodes[0], { const_cast<JsonObject*>(&root), nullptr, nullptr }, targets);
+}
+
+std::vector<JsonTarget> JsonPointerSet::Resolve(const JsonObject& root) const
+{
+    std::vector<JsonTarget> targets;
+    Resolve(root, targets);
+    return targets;
+}
+
+void JsonPointerSet::Resolve(const Node& node, const JsonPointer::Container& container,
+                             std::vector<JsonTarget>& targets) const
+{
+    for (const uint32_t index : node.children)
+    {
+        const Node&      child  = mNodes[index];
+        const JsonTarget target = JsonPointer::Step(container, child.token);
+        if (!target)
+        {
+            continue;
+        }
+
+        for (const uint32_t pointer : child.pointers)
+        {
+            targets[pointer] = target;
+        }
+
+        if (!child.children.empty())
+        {
+            const JsonPointer::Container next = JsonPointer::Enter(target);
+            if (next.object || next.array)
+            {
+                Resolve(child, next, targets);
+            }
+        }
+    }
+}
+
+} // namespace cereal
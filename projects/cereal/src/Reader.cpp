@@ -0,0 +1,426 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Reader
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#include "Reader.h"
+#include "Escape.h"
+#include "Grammar.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace cereal
+{
+
+size_t StreamSource::Read(char* buffer, const size_t size)
+{
+    mStream.read(buffer, static_cast<std::streamsize>(size));
+    return static_cast<size_t>(mStream.gcount());
+}
+
+size_t StringSource::Read(char* buffer, const size_t size)
+{
+    const size_t count = (std::min)(size, mJson.size());
+    std::memcpy(buffer, mJson.data(), count);
+    mJson.remove_prefix(count);
+    return count;
+}
+
+JsonReader::JsonReader(JsonSource& source, const size_t windowSize) : mSource(source), mBuffer((std::max)(windowSize, size_t{ 16 })) {}
+
+void JsonReader::Error(const std::string_view message) const
+{
+    throw std::runtime_error("Json parse error at offset " + std::to_string(Offset()) + ": " + std::string(message));
+}
+
+// Moves whatever has not been consumed yet to the front of the window and reads more input behind it. The window only
+// grows if it is already full, which means a single token is larger than it
+bool JsonReader::Fill()
+{
+    if (mEof)
+    {
+        return false;
+    }
+
+    if (mPos > 0)
+    {
+        std::memmove(mBuffer.data(), mBuffer.data() + mPos, mEnd - mPos);
+        mConsumed += mPos;
+        mEnd -= mPos;
+        mPos = 0;
+    }
+
+    if (mEnd == mBuffer.size())
+    {
+        mBuffer.resize(mBuffer.size() * 2);
+    }
+
+    const size_t read = mSource.Read(mBuffer.data() + mEnd, mBuffer.size() - mEnd);
+    if (read == 0)
+    {
+        mEof = true;
+        return false;
+    }
+    mEnd += read;
+    return true;
+}
+
+bool JsonReader::Available(const size_t count)
+{
+    while (mEnd - mPos < count)
+    {
+        if (!Fill())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JsonReader::SkipWhitespace()
+{
+    for (;;)
+    {
+        while (mPos < mEnd)
+        {
+            const char c = mBuffer[mPos];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+            {
+                return true;
+            }
+            ++mPos;
+        }
+        if (!Fill())
+        {
+            return false;
+        }
+    }
+}
+
+JsonReader::Event JsonReader::Next()
+{
+    mLast = NextEvent();
+    return mLast;
+}
+
+JsonReader::Event JsonReader::NextEvent()
+{
+    for (;;)
+    {
+        if (!SkipWhitespace())
+        {
+            if (mExpect != Expect::Done)
+            {
+                Error("unexpected end of document");
+            }
+            return Event::EndOfDocument;
+        }
+
+        const char c = mBuffer[mPos];
+        switch (mExpect)
+        {
+        case Expect::Value: return ReadValue(c);
+        case Expect::ValueOrArrayEnd: return c == ']' ? ReadEnd(c) : ReadValue(c);
+        case Expect::KeyOrObjectEnd:
+            if (c == '}')
+            {
+                return ReadEnd(c);
+            }
+            [[fallthrough]];
+        case Expect::Key:
+            if (c != '"')
+            {
+                Error("expected a key");
+            }
+            ReadString();
+            mExpect = Expect::Colon;
+            return Event::Key;
+        case Expect::Colon:
+            if (c != ':')
+            {
+                Error("expected ':' after key");
+            }
+            ++mPos;
+            mExpect = Expect::Value;
+            break;
+        case Expect::CommaOrEnd:
+            if (c != ',')
+            {
+                return ReadEnd(c);
+            }
+            ++mPos;
+            mExpect = mStack.back() == '{' ? Expect::Key : Expect::Value;
+            break;
+        case Expect::Done: Error("unexpected data after the document");
+        }
+    }
+}
+
+JsonReader::Event JsonReader::ReadValue(const char c)
+{
+    switch (c)
+    {
+    case '{':
+        ++mPos;
+        mStack.push_back('{');
+        mExpect = Expect::KeyOrObjectEnd;
+        return Event::StartObject;
+    case '[':
+        ++mPos;
+        mStack.push_back('[');
+        mExpect = Expect::ValueOrArrayEnd;
+        return Event::StartArray;
+    case '"':
+        ReadString();
+        AfterValue();
+        return Event::String;
+    case 't': mBool = true; return ReadLiteral("true", Event::Bool);
+    case 'f': mBool = false; return ReadLiteral("false", Event::Bool);
+    case 'n': return ReadLiteral("null", Event::Null);
+    default:
+        if (c == '-' || (c >= '0' && c <= '9'))
+        {
+            return ReadNumber();
+        }
+        Error("expected a value");
+    }
+}
+
+JsonReader::Event JsonReader::ReadEnd(const char c)
+{
+    const char open = mStack.empty() ? '\0' : mStack.back();
+    if ((c == '}' && open != '{') || (c == ']' && open != '['))
+    {
+        Error(std::string("unexpected '") + c + "'");
+    }
+    if (c != '}' && c != ']')
+    {
+        Error(open == '{' ? "expected ',' or '}'" : "expected ',' or ']'");
+    }
+
+    ++mPos;
+    mStack.pop_back();
+    AfterValue();
+    return c == '}' ? Event::EndObject : Event::EndArray;
+}
+
+void JsonReader::ReadString()
+{
+    // Offsets are kept relative to mPos because Fill moves the unread part of the window to the front
+    size_t rel       = 1;
+    bool   hasEscape = false;
+    for (;;)
+    {
+        if (mPos + rel >= mEnd)
+        {
+            if (!Fill())
+            {
+                Error("unterminated string");
+            }
+            continue;
+        }
+
+        const char* start = mBuffer.data() + mPos + rel;
+        const char* end   = mBuffer.data() + mEnd;
+        const char* p     = start;
+        while (p < end && *p != '"' && *p != '\\' && static_cast<unsigned char>(*p) >= 0x20)
+        {
+            ++p;
+        }
+        rel += p - start;
+        if (p == end)
+        {
+            continue;
+        }
+
+        if (*p == '"')
+        {
+            break;
+        }
+        if (*p == '\\')
+        {
+            hasEscape = true;
+            rel += 2;
+            continue;
+        }
+        mPos += rel;
+        Error("unescaped control character in string");
+    }
+
+    const std::string_view raw(mBuffer.data() + mPos + 1, rel - 1);
+    mPos += rel + 1;
+
+    if (!hasEscape || mSkipping)
+    {
+        mString = raw;
+        return;
+    }
+
+    mScratch.clear();
+    try
+    {
+        WriteUnescaped(mScratch, raw);
+    } catch (const std::runtime_error& e)
+    {
+        Error(e.what());
+    }
+    mString = mScratch;
+}
+
+bool JsonReader::ParsesAsInteger(const char* first, const char* last)
+{
+    // Integers outside the range of int64_t are read as doubles instead
+    const auto [ptr, errcode] = std::from_chars(first, last, mInteger);
+    return errcode == std::errc() && ptr == last;
+}
+
+JsonReader::Event JsonReader::ReadNumber()
+{
+    size_t rel = 0;
+    for (;;)
+    {
+        if (mPos + rel >= mEnd)
+        {
+            if (!Fill())
+            {
+                break;
+            }
+            continue;
+        }
+
+        const char c = mBuffer[mPos + rel];
+        if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E')
+        {
+            break;
+        }
+        ++rel;
+    }
+
+    const std::string_view token(mBuffer.data() + mPos, rel);
+    const char*            first = token.data();
+    const char*            last  = token.data() + token.size();
+
+    // The same grammar Parse holds numbers to, from_chars alone would take 01 or 1.
+    if (!detail::IsJsonNumber(token))
+    {
+        Error("invalid number '" + std::string(token) + "'");
+    }
+
+    Event event = Event::Double;
+    if (mSkipping)
+    {
+        // Only the shape of the token matters when nobody is going to look at the value
+    } else if (token.find_first_of(".eE") == std::string_view::npos && ParsesAsInteger(first, last))
+    {
+        event = Event::Integer;
+    } else
+    {
+        const auto [ptr, errcode] = std::from_chars(first, last, mDouble);
+        if (errcode != std::errc() || ptr != last)
+        {
+            Error("invalid number '" + std::string(token) + "'");
+        }
+    }
+
+    mPos += rel;
+    AfterValue();
+    return event;
+}
+
+JsonReader::Event JsonReader::ReadLiteral(const std::string_view literal, const Event event)
+{
+    if (!Available(literal.size()) || std::string_view(mBuffer.data() + mPos, literal.size()) != literal)
+    {
+        Error("invalid literal");
+    }
+    mPos += literal.size();
+    AfterValue();
+    return event;
+}
+
+void JsonReader::AfterValue()
+{
+    mExpect = mStack.empty() ? Expect::Done : Expect::CommaOrEnd;
+}
+
+void JsonReader::SkipValue()
+{
+    size_t depth = 0;
+    if (mLast == Event::StartObject || mLast == Event::StartArray)
+    {
+        depth = mStack.size() - 1;
+    } else if (mLast == Event::Key)
+    {
+        depth = mStack.size();
+    } else
+    {
+        return;
+    }
+
+    mSkipping = true;
+    if (mLast == Event::Key)
+    {
+        Next();
+    }
+    while (mStack.size() > depth)
+    {
+        Next();
+    }
+    mSkipping = false;
+}
+
+bool JsonReader::Parse(JsonHandler& handler)
+{
+    using Action = JsonHandler::Action;
+
+    for (;;)
+    {
+        Action action = Action::Continue;
+        switch (Next())
+        {
+        case Event::StartObject: action = handler.StartObject(); break;
+        case Event::EndObject: action = handler.EndObject(); break;
+        case Event::StartArray: action = handler.StartArray(); break;
+        case Event::EndArray: action = handler.EndArray(); break;
+        case Event::Key: action = handler.Key(mString); break;
+        case Event::String: action = handler.String(mString); break;
+        case Event::Integer: action = handler.Integer(mInteger); break;
+        case Event::Double: action = handler.Double(mDouble); break;
+        case Event::Bool: action = handler.Bool(mBool); break;
+        case Event::Null: action = handler.Null(); break;
+        case Event::EndOfDocument: return true;
+        }
+
+        if (action == Action::Stop)
+        {
+            return false;
+        }
+        if (action == Action::Skip)
+        {
+            SkipValue();
+        }
+    }
+}
+
+} // namespace cereal
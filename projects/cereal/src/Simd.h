@@ -0,0 +1,106 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: Simd.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+// Only x64 gets the vector kernels, 32-bit builds can't count on SSE2 being enabled and take the scalar path
+#if defined(__x86_64__) || defined(_M_X64)
+    #define CEREAL_SIMD_SSE2 1
+    #include <emmintrin.h>
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER)
+        #define CEREAL_TARGET_AVX2
+    #else
+        #define CEREAL_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+namespace cereal::detail
+{
+
+inline int CountTrailingZeros(const uint64_t mask)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#elif defined(_MSC_VER)
+    // No 64-bit scan on 32-bit targets, look at the low half first
+    unsigned long index;
+    if (_BitScanForward(&index, static_cast<uint32_t>(mask)))
+    {
+        return static_cast<int>(index);
+    }
+    _BitScanForward(&index, static_cast<uint32_t>(mask >> 32));
+    return static_cast<int>(index) + 32;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+#ifdef CEREAL_SIMD_SSE2
+
+// Checked once, the kernels that have an AVX2 version pick it at runtime so the library itself can be built for
+// plain x86-64
+inline bool CpuHasAvx2()
+{
+    static const bool hasAvx2 = [] {
+    #if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+        {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 5)) == 0)
+        {
+            return false;
+        }
+
+        // The cpu having AVX2 isn't enough, the OS has to save the YMM registers too or the first AVX2 instruction
+        // faults. OSXSAVE says xgetbv can be asked, and bits 1 and 2 of XCR0 say SSE and AVX state are saved
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0)
+        {
+            return false;
+        }
+        return (_xgetbv(0) & 0x6) == 0x6;
+    #else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    #endif
+    }();
+    return hasAvx2;
+}
+
+#endif
+
+} // namespace cereal::detail
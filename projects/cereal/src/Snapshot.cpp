@@ -0,0 +1,585 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Snapshot.cpp
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "Snapshot.h"
+#include "Writer.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cereal
+{
+
+namespace detail
+{
+
+// Member names in order. Versions that only change values share them
+struct SnapshotKeys
+{
+    std::vector<std::string>                       names;
+    std::unordered_map<std::string_view, uint32_t> index; // Empty until there are more than IndexThreshold names
+};
+
+struct SnapshotNode
+{
+    using Chunk = std::vector<SnapshotMember>;
+
+    std::shared_ptr<const SnapshotKeys>       keys;
+    std::vector<std::shared_ptr<const Chunk>> chunks;
+
+    [[nodiscard]] size_t Size() const { return keys->names.size(); }
+
+    [[nodiscard]] const SnapshotMember& At(const size_t position) const
+    {
+        return (*chunks[position / JsonSnapshot::ChunkSize])[position % JsonSnapshot::ChunkSize];
+    }
+};
+
+} // namespace detail
+
+namespace
+{
+
+using detail::SnapshotKeys;
+using detail::SnapshotMember;
+using detail::SnapshotNode;
+
+constexpr uint32_t NotFound = UINT32_MAX;
+
+uint32_t Find(const SnapshotNode& node, const std::string_view key)
+{
+    const SnapshotKeys& keys = *node.keys;
+    if (keys.index.empty())
+    {
+        for (size_t i = 0; i < keys.names.size(); ++i)
+        {
+            if (keys.names[i] == key)
+            {
+                return static_cast<uint32_t>(i);
+            }
+        }
+        return NotFound;
+    }
+
+    const auto found = keys.index.find(key);
+    return found == keys.index.end() ? NotFound : found->second;
+}
+
+std::shared_ptr<const SnapshotKeys> MakeKeys(std::vector<std::string> names)
+{
+    auto keys   = std::make_shared<SnapshotKeys>();
+    keys->names = std::move(names);
+    if (keys->names.size() > ValueMap::IndexThreshold)
+    {
+        keys->index.reserve(keys->names.size());
+        for (size_t i = 0; i < keys->names.size(); ++i)
+        {
+            keys->index.emplace(keys->names[i], static_cast<uint32_t>(i));
+        }
+    }
+    return keys;
+}
+
+std::shared_ptr<const SnapshotNode> MakeNode(std::shared_ptr<const SnapshotKeys> keys, std::vector<SnapshotMember>&& members)
+{
+    auto node  = std::make_shared<SnapshotNode>();
+    node->keys = std::move(keys);
+    node->chunks.reserve((members.size() + JsonSnapshot::ChunkSize - 1) / JsonSnapshot::ChunkSize);
+    for (size_t first = 0; first < members.size(); first += JsonSnapshot::ChunkSize)
+    {
+        const size_t last = std::min(first + JsonSnapshot::ChunkSize, members.size());
+        node->chunks.push_back(std::make_shared<const SnapshotNode::Chunk>(std::make_move_iterator(members.begin() + first),
+                                                                            std::make_move_iterator(members.begin() + last)));
+    }
+    return node;
+}
+
+// Every member in order, for the rare changes that shift them
+std::vector<SnapshotMember> Members(const SnapshotNode& node)
+{
+    std::vector<SnapshotMember> members;
+    members.reserve(node.Size());
+    for (const auto& chunk : node.chunks)
+    {
+        members.insert(members.end(), chunk->begin(), chunk->end());
+    }
+    return members;
+}
+
+JsonObject DeepCopy(const JsonObject& object, std::pmr::memory_resource* resource);
+
+std::shared_ptr<JsonObject> SharedCopy(const JsonObject& object, std::pmr::memory_resource* resource)
+{
+    return std::allocate_shared<JsonObject>(std::pmr::polymorphic_allocator<JsonObject>(resource), DeepCopy(object, resource));
+}
+
+// A copy of value that owns everything in it, nested objects included, so nothing it holds is shared with value
+JsonValue Own(const JsonValue& value, std::pmr::memory_resource* resource)
+{
+    JsonValue copy;
+    switch (value.GetType())
+    {
+    case JsonType::Object:
+        if (const std::shared_ptr<JsonObject>& child = value.Get<std::shared_ptr<JsonObject>>())
+        {
+            copy.Assign(SharedCopy(*child, resource), resource);
+        } else
+        {
+            copy.Assign(value, resource);
+        }
+        break;
+    case JsonType::InlineObject: copy.Assign(DeepCopy(value.Get<JsonObject>(), resource), resource); break;
+    case JsonType::Span:
+    case JsonType::Array:
+        detail::WithElementType(value.ElementType(), [&copy, &value, resource]<typename E>(std::type_identity<E>) {
+            const std::span<E> elements = value.Get<std::span<E>>();
+            std::vector<E>     owned;
+            owned.reserve(elements.size());
+            for (const E& element : elements)
+            {
+                if constexpr (std::is_same_v<E, std::shared_ptr<JsonObject>>)
+                {
+                    owned.push_back(element ? SharedCopy(*element, resource) : nullptr);
+                } else if constexpr (std::is_same_v<E, JsonObject>)
+                {
+                    owned.push_back(DeepCopy(element, resource));
+                } else
+                {
+                    owned.push_back(element);
+                }
+            }
+            copy.Assign(std::move(owned), resource);
+        });
+        break;
+    default: copy.Assign(value, resource); break;
+    }
+    return copy;
+}
+
+JsonObject DeepCopy(const JsonObject& object, std::pmr::memory_resource* resource)
+{
+    JsonObject copy(resource);
+    for (const auto& [key, value] : object.GetValues())
+    {
+        copy.Add(std::string_view(key), Own(value, resource));
+    }
+    return copy;
+}
+
+std::shared_ptr<const SnapshotNode> Freeze(const JsonObject& object);
+
+SnapshotMember Freeze(const JsonValue& value)
+{
+    if (value.GetType() == JsonType::InlineObject)
+    {
+        return { nullptr, Freeze(value.Get<JsonObject>()) };
+    }
+    if (value.GetType() == JsonType::Object && value.Get<std::shared_ptr<JsonObject>>())
+    {
+        return { nullptr, Freeze(*value.Get<std::shared_ptr<JsonObject>>()) };
+    }
+    return { std::make_shared<const JsonValue>(Own(value, std::pmr::get_default_resource())), nullptr };
+}
+
+std::shared_ptr<const SnapshotNode> Freeze(const JsonObject& object)
+{
+    std::vector<std::string>    names;
+    std::vector<SnapshotMember> members;
+    names.reserve(object.GetValues().size());
+    members.reserve(object.GetValues().size());
+    for (const auto& [key, value] : object.GetValues())
+    {
+        names.emplace_back(std::string_view(key));
+        members.push_back(Freeze(value));
+    }
+    return MakeNode(MakeKeys(std::move(names)), std::move(members));
+}
+
+// node with the member at position swapped for member. Only the chunk holding it is copied
+std::shared_ptr<const SnapshotNode> WithMember(const SnapshotNode& node, const size_t position, SnapshotMember member)
+{
+    auto  copy  = std::make_shared<SnapshotNode>(node);
+    auto& chunk = copy->chunks[position / JsonSnapshot::ChunkSize];
+    auto  next  = std::make_shared<SnapshotNode::Chunk>(*chunk);
+    (*next)[position % JsonSnapshot::ChunkSize] = std::move(member);
+    chunk = std::move(next);
+    return copy;
+}
+
+// node with member added after the others. Only the last chunk is copied, or a new one is started
+std::shared_ptr<const SnapshotNode> WithNewMember(const SnapshotNode& node, const std::string_view key, SnapshotMember member)
+{
+    std::vector<std::string> names;
+    names.reserve(node.Size() + 1);
+    names = node.keys->names;
+    names.emplace_back(key);
+
+    auto copy  = std::make_shared<SnapshotNode>(node);
+    copy->keys = MakeKeys(std::move(names));
+    if (node.Size() % JsonSnapshot::ChunkSize == 0)
+    {
+        copy->chunks.push_back(std::make_shared<const SnapshotNode::Chunk>(1, std::move(member)));
+    } else
+    {
+        auto last = std::make_shared<SnapshotNode::Chunk>(*copy->chunks.back());
+        last->push_back(std::move(member));
+        copy->chunks.back() = std::move(last);
+    }
+    return copy;
+}
+
+// node without the member at position. The members after it all move up, so the chunks are laid out again
+std::shared_ptr<const SnapshotNode> WithoutMember(const SnapshotNode& node, const size_t position)
+{
+    std::vector<std::string> names = node.keys->names;
+    names.erase(names.begin() + static_cast<std::ptrdiff_t>(position));
+
+    std::vector<SnapshotMember> members = Members(node);
+    members.erase(members.begin() + static_cast<std::ptrdiff_t>(position));
+    return MakeNode(MakeKeys(std::move(names)), std::move(members));
+}
+
+void MaterializeInto(const SnapshotNode& node, JsonObject& object)
+{
+    for (size_t i = 0; i < node.Size(); ++i)
+    {
+        const SnapshotMember& member = node.At(i);
+        if (member.object)
+        {
+            std::shared_ptr<JsonObject> child = object.CreateObject();
+            MaterializeInto(*member.object, *child);
+            object.Add(std::string_view(node.keys->names[i]), std::move(child));
+        } else
+        {
+            object.Add(std::string_view(node.keys->names[i]), Own(*member.value, object.GetResource()));
+        }
+    }
+}
+
+template<typename Output>
+void WriteNode(JsonWriter& writer, const SnapshotNode& node, int indentLevel, int indentSize);
+
+template<typename Output>
+void WriteMember(JsonWriter& writer, const SnapshotNode& node, const size_t position, const bool separator,
+                 const int indentLevel, const int indentSize)
+{
+    if (separator)
+    {
+        writer.Append(Output::Pretty ? ", \n" : Output::Canonical ? "," : ", ");
+    }
+    if constexpr (Output::Pretty)
+    {
+        writer.AppendIndent(static_cast<size_t>(indentLevel + 1) * indentSize);
+    }
+    writer.AppendString(node.keys->names[position]);
+    writer.Append(Output::Canonical ? ":" : ": ");
+
+    const SnapshotMember& member = node.At(position);
+    if (member.object)
+    {
+        WriteNode<Output>(writer, *member.object, indentLevel + 1, indentSize);
+    } else if constexpr (Output::Canonical)
+    {
+        writer.AppendCanonical(*member.value);
+    } else
+    {
+        writer.AppendValue(*member.value);
+    }
+    writer.MaybeFlush();
+}
+
+template<typename Output>
+void WriteNode(JsonWriter& writer, const SnapshotNode& node, const int indentLevel, const int indentSize)
+{
+    writer.Append(Output::Pretty ? "{\n" : "{");
+
+    if constexpr (Output::Canonical)
+    {
+        const std::vector<std::string>& names = node.keys->names;
+        std::vector<uint32_t>           order(names.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = static_cast<uint32_t>(i);
+        }
+        std::sort(order.begin(), order.end(), [&names](const uint32_t lhs, const uint32_t rhs) {
+            return std::string_view(names[lhs]) < std::string_view(names[rhs]);
+        });
+
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            WriteMember<Output>(writer, node, order[i], i != 0, 0, 0);
+        }
+    } else
+    {
+        for (size_t i = 0; i < node.Size(); ++i)
+        {
+            WriteMember<Output>(writer, node, i, i != 0, indentLevel, indentSize);
+        }
+    }
+
+    if constexpr (Output::Pretty)
+    {
+        writer.AppendNewLine(static_cast<size_t>(indentLevel) * indentSize);
+    }
+    writer.Append('}');
+}
+
+// The object the last token of path is looked up in, with the object each earlier token stepped into
+const SnapshotNode& Parent(const SnapshotNode& root, const JsonPointer& path, std::vector<const SnapshotNode*>& nodes,
+                           std::vector<uint32_t>& positions)
+{
+    const SnapshotNode* node = &root;
+    for (size_t i = 0; i + 1 < path.Size(); ++i)
+    {
+        const uint32_t position = Find(*node, path.Token(i));
+        if (position == NotFound || !node->At(position).object)
+        {
+            path.ThrowNotFound(i);
+        }
+        nodes.push_back(node);
+        positions.push_back(position);
+        node = node->At(position).object.get();
+    }
+    return *node;
+}
+
+// Copies the objects path stepped through, from the bottom up, each pointing at the copy below it
+std::shared_ptr<const SnapshotNode> CopyPath(const std::vector<const SnapshotNode*>& nodes,
+                                             const std::vector<uint32_t>& positions, std::shared_ptr<const SnapshotNode> node)
+{
+    for (size_t i = nodes.size(); i-- > 0;)
+    {
+        node = WithMember(*nodes[i], positions[i], { nullptr, std::move(node) });
+    }
+    return node;
+}
+
+const std::shared_ptr<const SnapshotNode>& EmptyNode()
+{
+    static const std::shared_ptr<const SnapshotNode> empty = MakeNode(MakeKeys({}), {});
+    return empty;
+}
+
+} // namespace
+
+JsonSnapshot::JsonSnapshot() : mRoot(EmptyNode()) {}
+
+JsonSnapshot::JsonSnapshot(const JsonObject& object) : mRoot(Freeze(object)) {}
+
+JsonSnapshot JsonSnapshot::GetObject(const std::string_view key) const
+{
+    const SnapshotMember& member = Locate(key);
+    if (!member.object)
+    {
+        member.value->ThrowTypeMismatch(GetTypeName<std::shared_ptr<JsonObject>>(), key);
+    }
+    return JsonSnapshot(member.object);
+}
+
+JsonSnapshot JsonSnapshot::GetObject(const JsonPointer& path) const
+{
+    if (path.Size() == 0)
+    {
+        return *this;
+    }
+
+    size_t                element = JsonTarget::WholeValue;
+    const SnapshotMember& member  = Locate(path, element);
+    if (!member.object)
+    {
+        member.value->ThrowTypeMismatch(GetTypeName<std::shared_ptr<JsonObject>>(), path.ToString());
+    }
+    return JsonSnapshot(member.object);
+}
+
+bool JsonSnapshot::Contains(const std::string_view key) const
+{
+    return Find(*mRoot, key) != NotFound;
+}
+
+size_t JsonSnapshot::Size() const
+{
+    return mRoot->Size();
+}
+
+JsonSnapshot JsonSnapshot::Set(const JsonPointer& path, const JsonSnapshot& object) const
+{
+    return Replace(path, { nullptr, object.mRoot });
+}
+
+JsonSnapshot JsonSnapshot::Set(const std::string_view key, const JsonSnapshot& object) const
+{
+    return Replace(key, { nullptr, object.mRoot });
+}
+
+JsonSnapshot JsonSnapshot::Erase(const JsonPointer& path) const
+{
+    if (path.Size() == 0)
+    {
+        path.ThrowNotFound(0);
+    }
+
+    std::vector<const SnapshotNode*> nodes;
+    std::vector<uint32_t>            positions;
+    const SnapshotNode&              parent   = Parent(*mRoot, path, nodes, positions);
+    const uint32_t                   position = Find(parent, path.Token(path.Size() - 1));
+    if (position == NotFound)
+    {
+        path.ThrowNotFound(path.Size() - 1);
+    }
+    return JsonSnapshot(CopyPath(nodes, positions, WithoutMember(parent, position)));
+}
+
+JsonSnapshot JsonSnapshot::Erase(const std::string_view key) const
+{
+    const uint32_t position = Find(*mRoot, key);
+    if (position == NotFound)
+    {
+        JsonObject::ThrowKeyNotFound(key);
+    }
+    return JsonSnapshot(WithoutMember(*mRoot, position));
+}
+
+std::string JsonSnapshot::ToString(bool pretty, int indentLevel, int indentSize) const
+{
+    std::string out;
+    JsonWriter  writer(out);
+    Write(writer, pretty, indentLevel, indentSize);
+    return out;
+}
+
+void JsonSnapshot::Write(JsonWriter& writer, bool pretty, int indentLevel, int indentSize) const
+{
+    if (pretty)
+    {
+        WriteNode<PrettyOutput>(writer, *mRoot, indentLevel, indentSize);
+    } else
+    {
+        WriteNode<CompactOutput>(writer, *mRoot, indentLevel, indentSize);
+    }
+}
+
+std::string JsonSnapshot::ToCanonicalString() const
+{
+    std::string out;
+    JsonWriter  writer(out);
+    WriteNode<CanonicalOutput>(writer, *mRoot, 0, 0);
+    return out;
+}
+
+JsonObject JsonSnapshot::Materialize(std::pmr::memory_resource* resource) const
+{
+    JsonObject object(resource);
+    MaterializeInto(*mRoot, object);
+    return object;
+}
+
+const SnapshotMember& JsonSnapshot::Locate(const std::string_view key) const
+{
+    const uint32_t position = Find(*mRoot, key);
+    if (position == NotFound)
+    {
+        JsonObject::ThrowKeyNotFound(key);
+    }
+    return mRoot->At(position);
+}
+
+const SnapshotMember& JsonSnapshot::Locate(const JsonPointer& path, size_t& element) const
+{
+    const SnapshotNode* node = mRoot.get();
+    for (size_t i = 0; i < path.Size(); ++i)
+    {
+        const uint32_t position = Find(*node, path.Token(i));
+        if (position == NotFound)
+        {
+            path.ThrowNotFound(i);
+        }
+
+        const SnapshotMember& member = node->At(position);
+        if (i + 1 == path.Size())
+        {
+            return member;
+        }
+        if (member.object)
+        {
+            node = member.object.get();
+            continue;
+        }
+
+        // Only the last token can index into an array, whose elements snapshots don't step into
+        const size_t index = i + 2 == path.Size() ? path.Index(i + 1) : JsonPointer::NotAnIndex;
+        if (index >= member.value->ElementCount())
+        {
+            path.ThrowNotFound(i + 1);
+        }
+        element = index;
+        return member;
+    }
+    path.ThrowNotFound(0);
+}
+
+SnapshotMember JsonSnapshot::MakeMember(JsonValue&& value)
+{
+    return Freeze(value);
+}
+
+JsonSnapshot JsonSnapshot::Replace(const JsonPointer& path, SnapshotMember member) const
+{
+    if (path.Size() == 0)
+    {
+        if (!member.object)
+        {
+            throw std::runtime_error("JSON pointer \"\" refers to the document itself, which can only be set to an object");
+        }
+        return JsonSnapshot(std::move(member.object));
+    }
+
+    std::vector<const SnapshotNode*> nodes;
+    std::vector<uint32_t>            positions;
+    const SnapshotNode&              parent   = Parent(*mRoot, path, nodes, positions);
+    const std::string_view           last     = path.Token(path.Size() - 1);
+    const uint32_t                   position = Find(parent, last);
+    return JsonSnapshot(CopyPath(nodes, positions,
+                                 position == NotFound ? WithNewMember(parent, last, std::move(member))
+                                                      : WithMember(parent, position, std::move(member))));
+}
+
+JsonSnapshot JsonSnapshot::Replace(const std::string_view key, SnapshotMember member) const
+{
+    const uint32_t position = Find(*mRoot, key);
+    return JsonSnapshot(position == NotFound ? WithNewMember(*mRoot, key, std::move(member))
+                                             : WithMember(*mRoot, position, std::move(member)));
+}
+
+void JsonSnapshot::ThrowObjectMismatch(const std::string& expectedType, const std::string_view key)
+{
+    // Objects are held as snapshots, but the error names what JsonObject::Get would have found in their place
+    const JsonValue object(std::shared_ptr<JsonObject>{});
+    object.ThrowTypeMismatch(expectedType, key);
+}
+
+} // namespace cereal
@@ -0,0 +1,260 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: StructuralIndex
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#include "StructuralIndex.h"
+
+#include "Simd.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace cereal::detail
+{
+
+namespace
+{
+
+// One bit per byte of a 64 byte block
+struct BlockMasks
+{
+    uint64_t quote      = 0;
+    uint64_t backslash  = 0;
+    uint64_t structural = 0;
+    uint64_t whitespace = 0;
+    uint64_t control    = 0;
+};
+
+#ifdef CEREAL_SIMD_SSE2
+
+uint64_t MoveMask(const __m128i mask, const int chunk)
+{
+    return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(mask))) << (chunk * 16);
+}
+
+__m128i Equals(const __m128i chunk, const char c)
+{
+    return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c));
+}
+
+void ClassifySse2(const char* block, BlockMasks& masks)
+{
+    const __m128i control = _mm_set1_epi8(0x1F);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+
+        const __m128i brackets =
+            _mm_or_si128(_mm_or_si128(Equals(c, '{'), Equals(c, '}')), _mm_or_si128(Equals(c, '['), Equals(c, ']')));
+        const __m128i separators = _mm_or_si128(Equals(c, ':'), Equals(c, ','));
+        const __m128i whitespace =
+            _mm_or_si128(_mm_or_si128(Equals(c, ' '), Equals(c, '\t')), _mm_or_si128(Equals(c, '\n'), Equals(c, '\r')));
+
+        masks.quote |= MoveMask(Equals(c, '"'), i);
+        masks.backslash |= MoveMask(Equals(c, '\\'), i);
+        masks.structural |= MoveMask(_mm_or_si128(brackets, separators), i);
+        masks.whitespace |= MoveMask(whitespace, i);
+        masks.control |= MoveMask(_mm_cmpeq_epi8(_mm_max_epu8(c, control), control), i);
+    }
+}
+
+CEREAL_TARGET_AVX2 uint64_t MoveMask(const __m256i mask, const int chunk)
+{
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(mask))) << (chunk * 32);
+}
+
+CEREAL_TARGET_AVX2 __m256i Equals(const __m256i chunk, const char c)
+{
+    return _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c));
+}
+
+CEREAL_TARGET_AVX2 void ClassifyAvx2(const char* block, BlockMasks& masks)
+{
+    const __m256i control = _mm256_set1_epi8(0x1F);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i * 32));
+
+        const __m256i brackets =
+            _mm256_or_si256(_mm256_or_si256(Equals(c, '{'), Equals(c, '}')), _mm256_or_si256(Equals(c, '['), Equals(c, ']')));
+        const __m256i separators = _mm256_or_si256(Equals(c, ':'), Equals(c, ','));
+        const __m256i whitespace =
+            _mm256_or_si256(_mm256_or_si256(Equals(c, ' '), Equals(c, '\t')), _mm256_or_si256(Equals(c, '\n'), Equals(c, '\r')));
+
+        masks.quote |= MoveMask(Equals(c, '"'), i);
+        masks.backslash |= MoveMask(Equals(c, '\\'), i);
+        masks.structural |= MoveMask(_mm256_or_si256(brackets, separators), i);
+        masks.whitespace |= MoveMask(whitespace, i);
+        masks.control |= MoveMask(_mm256_cmpeq_epi8(_mm256_max_epu8(c, control), control), i);
+    }
+}
+
+using ClassifyFn = void (*)(const char*, BlockMasks&);
+
+ClassifyFn SelectClassifier()
+{
+    return CpuHasAvx2() ? ClassifyAvx2 : ClassifySse2;
+}
+
+#else
+
+void ClassifyScalar(const char* block, BlockMasks& masks)
+{
+    for (int i = 0; i < 64; ++i)
+    {
+        const auto     c   = static_cast<unsigned char>(block[i]);
+        const uint64_t bit = uint64_t{ 1 } << i;
+        switch (c)
+        {
+        case '"': masks.quote |= bit; break;
+        case '\\': masks.backslash |= bit; break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',': masks.structural |= bit; break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r': masks.whitespace |= bit; break;
+        default: break;
+        }
+        if (c < 0x20)
+        {
+            masks.control |= bit;
+        }
+    }
+}
+
+using ClassifyFn = void (*)(const char*, BlockMasks&);
+
+ClassifyFn SelectClassifier()
+{
+    return ClassifyScalar;
+}
+
+#endif
+
+// Each bit becomes the xor of itself and every bit below it, turning opening/closing quote pairs into a mask that
+// covers the opening quote and the string contents
+uint64_t PrefixXor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// Characters preceded by an odd number of backslashes. Backslashes are rare enough in practice that walking them one
+// at a time is cheaper than doing the full carry arithmetic on every block
+uint64_t FindEscaped(uint64_t backslash, uint64_t& carry)
+{
+    uint64_t escaped = carry;
+    carry            = 0;
+
+    backslash &= ~escaped;
+    while (backslash)
+    {
+        const int i = CountTrailingZeros(backslash);
+        if (i == 63)
+        {
+            carry = 1;
+            break;
+        }
+        escaped |= uint64_t{ 1 } << (i + 1);
+        backslash &= ~(uint64_t{ 3 } << i);
+    }
+    return escaped;
+}
+
+} // namespace
+
+void BuildStructuralIndex(const std::string_view json, std::vector<uint32_t>& positions)
+{
+    if (json.size() >= std::numeric_limits<uint32_t>::max())
+    {
+        throw std::runtime_error("Json document is too large to index");
+    }
+
+    static const ClassifyFn classify = SelectClassifier();
+
+    positions.clear();
+    positions.reserve(json.size() / 8 + 16);
+
+    uint64_t escapeCarry = 0;
+    uint64_t inString    = 0; // all ones while a string is open across a block boundary
+    uint64_t scalarCarry = 0;
+
+    char tail[64];
+
+    for (size_t base = 0; base < json.size(); base += 64)
+    {
+        const char* block = json.data() + base;
+        if (json.size() - base < 64)
+        {
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, block, json.size() - base);
+            block = tail;
+        }
+
+        BlockMasks masks;
+        classify(block, masks);
+
+        const uint64_t escaped = FindEscaped(masks.backslash, escapeCarry);
+        const uint64_t quote   = masks.quote & ~escaped;
+        const uint64_t strings = PrefixXor(quote) ^ inString;
+        inString               = static_cast<uint64_t>(static_cast<int64_t>(strings) >> 63);
+
+        if (const uint64_t badControl = masks.control & strings & ~quote)
+        {
+            throw std::runtime_error("Json parse error at offset " + std::to_string(base + CountTrailingZeros(badControl)) +
+                                     ": unescaped control character in string");
+        }
+
+        const uint64_t structural  = masks.structural & ~strings;
+        const uint64_t scalar      = ~(masks.structural | masks.whitespace | quote | strings);
+        const uint64_t scalarStart = scalar & ~((scalar << 1) | scalarCarry);
+        scalarCarry                = scalar >> 63;
+
+        uint64_t bits = structural | quote | scalarStart;
+        while (bits)
+        {
+            positions.push_back(static_cast<uint32_t>(base + CountTrailingZeros(bits)));
+            bits &= bits - 1;
+        }
+    }
+
+    if (inString)
+    {
+        throw std::runtime_error("Json parse error: unterminated string");
+    }
+}
+
+} // namespace cereal::detail
@@ -0,0 +1,40 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+// Copyright 2025 Matthew Rogers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File Name: StructuralIndex.h
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace cereal::detail
+{
+
+// First stage of parsing. Records, in document order, the offset of every structural character ({ } [ ] : ,) and
+// every unescaped quote outside of string contents, plus the first character of every number or literal. The second
+// stage then only has to walk this list instead of looking at every byte again.
+//
+// Throws std::runtime_error for unterminated strings and raw control characters inside strings
+void BuildStructuralIndex(std::string_view json, std::vector<uint32_t>& positions);
+
+} // namespace cereal::detail
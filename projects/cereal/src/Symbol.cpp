@@ -0,0 +1,103 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Symbol.cpp
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "Symbol.h"
+#include "Escape.h"
+
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace cereal
+{
+
+SymbolTable& SymbolTable::Global()
+{
+    // Never destroyed, so objects destroyed along with other statics can still hold and write their keys
+    static SymbolTable* table = new SymbolTable();
+    return *table;
+}
+
+const Symbol& SymbolTable::Intern(const std::string_view text)
+{
+    if (const Symbol* symbol = Find(text))
+    {
+        return *symbol;
+    }
+
+    std::string fragment;
+    WriteEscapedString(fragment, text);
+    fragment += ": ";
+
+    std::unique_lock lock(mMutex);
+    if (const auto it = mLookup.find(text); it != mLookup.end())
+    {
+        return *it->second;
+    }
+
+    if (text.size() > UINT32_MAX || mSymbols.size() >= UINT32_MAX)
+    {
+        throw std::runtime_error("Too many or too long symbols to intern");
+    }
+
+    // One block holding the symbol, its text and its fragment. Text() relies on the text coming straight after
+    void*   memory = ::operator new(sizeof(Symbol) + text.size() + fragment.size());
+    Symbol* symbol = new (memory) Symbol(static_cast<uint32_t>(mSymbols.size()), detail::HashKey(text),
+                                         static_cast<uint32_t>(text.size()), static_cast<uint32_t>(fragment.size()));
+
+    char* chars = reinterpret_cast<char*>(symbol + 1);
+    std::memcpy(chars, text.data(), text.size());
+    std::memcpy(chars + text.size(), fragment.data(), fragment.size());
+
+    mSymbols.push_back(symbol);
+    mLookup.emplace(symbol->Text(), symbol);
+    return *symbol;
+}
+
+const Symbol* SymbolTable::Find(const std::string_view text) const
+{
+    std::shared_lock lock(mMutex);
+    const auto       it = mLookup.find(text);
+    return it != mLookup.end() ? it->second : nullptr;
+}
+
+const Symbol& SymbolTable::Get(const uint32_t id) const
+{
+    std::shared_lock lock(mMutex);
+    if (id >= mSymbols.size())
+    {
+        throw std::out_of_range("No symbol with id " + std::to_string(id));
+    }
+    return *mSymbols[id];
+}
+
+size_t SymbolTable::Size() const
+{
+    std::shared_lock lock(mMutex);
+    return mSymbols.size();
+}
+
+} // namespace cereal
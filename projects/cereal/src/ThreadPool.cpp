@@ -0,0 +1,137 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: ThreadPool.cpp
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "ThreadPool.h"
+
+#include <utility>
+
+namespace cereal
+{
+
+ThreadPool::ThreadPool(const unsigned threads)
+{
+    const unsigned workers = threads > 1 ? threads - 1 : 0;
+
+    mWorkers.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i)
+    {
+        mWorkers.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+
+    for (std::thread& worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::Run(const size_t count, const Task task, void* const context)
+{
+    if (mWorkers.empty() || count <= 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            task(context, i);
+        }
+        return;
+    }
+
+    std::lock_guard run(mRunMutex);
+    {
+        std::lock_guard lock(mMutex);
+        mTask    = task;
+        mContext = context;
+        mCount   = count;
+        mError   = nullptr;
+        mBusy    = static_cast<unsigned>(mWorkers.size());
+        mNext.store(0, std::memory_order_relaxed);
+        ++mGeneration;
+    }
+    mWake.notify_all();
+
+    Work();
+
+    std::unique_lock lock(mMutex);
+    mDone.wait(lock, [this] { return mBusy == 0; });
+
+    if (mError)
+    {
+        std::rethrow_exception(std::exchange(mError, nullptr));
+    }
+}
+
+void ThreadPool::Work()
+{
+    size_t i = 0;
+    while ((i = mNext.fetch_add(1, std::memory_order_relaxed)) < mCount)
+    {
+        try
+        {
+            mTask(mContext, i);
+        } catch (...)
+        {
+            std::lock_guard lock(mMutex);
+            if (!mError)
+            {
+                mError = std::current_exception();
+            }
+            mNext.store(mCount, std::memory_order_relaxed);
+        }
+    }
+}
+
+void ThreadPool::WorkerLoop()
+{
+    uint64_t seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(mMutex);
+            mWake.wait(lock, [this, seen] { return mStop || mGeneration != seen; });
+            if (mStop)
+            {
+                return;
+            }
+            seen = mGeneration;
+        }
+
+        Work();
+
+        std::lock_guard lock(mMutex);
+        if (--mBusy == 0)
+        {
+            mDone.notify_one();
+        }
+    }
+}
+
+} // namespace cereal
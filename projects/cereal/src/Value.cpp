@@ -0,0 +1,320 @@
+﻿// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: Value
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "Json.h"
+#include "Value.h"
+#include "Reader.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace cereal
+{
+
+namespace
+{
+
+// The value event starts, written the way CanonicalOutput lays values out. Members are written into buffers of their
+// own first, so they can be put in key order
+void WriteCanonicalValue(JsonReader& reader, const JsonReader::Event event, std::string& out)
+{
+    using Event = JsonReader::Event;
+
+    switch (event)
+    {
+    case Event::StartObject:
+    {
+        std::vector<std::pair<std::string, std::string>> members;
+        while (reader.Next() != Event::EndObject)
+        {
+            auto& [key, json] = members.emplace_back(reader.GetString(), std::string());
+            WriteCanonicalValue(reader, reader.Next(), json);
+        }
+
+        // Comparing std::strings compares bytes as unsigned, the same order JsonObject puts keys in
+        std::sort(members.begin(), members.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+
+        out += '{';
+        for (size_t i = 0; i < members.size(); ++i)
+        {
+            if (i != 0)
+            {
+                out += ',';
+            }
+            WriteItem(out, std::string_view(members[i].first));
+            out += ':';
+            out += members[i].second;
+        }
+        out += '}';
+        break;
+    }
+    case Event::StartArray:
+    {
+        out += '[';
+        bool first = true;
+        for (Event next = reader.Next(); next != Event::EndArray; next = reader.Next())
+        {
+            if (!first)
+            {
+                out += ',';
+            }
+            WriteCanonicalValue(reader, next, out);
+            first = false;
+        }
+        out += ']';
+        break;
+    }
+    case Event::String: WriteItem(out, reader.GetString()); break;
+    case Event::Integer: WriteCanonicalNumber(out, reader.GetInteger()); break;
+    case Event::Double: WriteCanonicalNumber(out, reader.GetDouble()); break;
+    case Event::Bool: WriteItem(out, reader.GetBool()); break;
+    default: WriteItem(out, nullptr); break;
+    }
+}
+
+} // namespace
+
+namespace detail
+{
+
+void WriteCanonicalJson(std::string& out, const std::string_view json)
+{
+    StringSource source(json);
+    JsonReader   reader(source);
+    WriteCanonicalValue(reader, reader.Next(), out);
+}
+
+} // namespace detail
+
+void JsonValue::Assign(const JsonValue& value, std::pmr::memory_resource* resource)
+{
+    if (this == &value)
+    {
+        return;
+    }
+
+    switch (value.mType)
+    {
+    case Type::String: Assign(value.Get<std::string>(), resource); return;
+    // Nothing says the text a view points into outlives this value, so like Type::String the copy owns it
+    case Type::StringView: Assign(value.Get<std::string_view>(), resource); return;
+    case Type::Object: Assign(value.Get<std::shared_ptr<JsonObject>>(), resource); return;
+    case Type::InlineObject: Assign(value.Get<JsonObject>(), resource); return;
+    case Type::Boxed: Set(Type::Boxed, value.mData.box->Clone(resource)); return;
+    case Type::Array:
+        detail::WithElementType(value.mElement, [this, &value, resource]<typename E>(std::type_identity<E>) {
+            const std::span<E> elements = value.Get<std::span<E>>();
+            Assign(std::vector<E>(elements.begin(), elements.end()), resource);
+        });
+        return;
+    default:
+        Reset();
+        mType    = value.mType;
+        mElement = value.mElement;
+        mSize    = value.mSize;
+        mData    = value.mData;
+        return;
+    }
+}
+
+void JsonValue::Reset() noexcept
+{
+    switch (mType)
+    {
+    case Type::String: detail::DeletePayload(mData.string); break;
+    case Type::Object: detail::DeletePayload(mData.object); break;
+    case Type::InlineObject: detail::DeletePayload(mData.inlineObject); break;
+    case Type::Boxed: mData.box->Destroy(); break;
+    case Type::Array:
+        detail::WithElementType(mElement, [this]<typename E>(std::type_identity<E>) { detail::DeletePayload(ArrayPayload<E>()); });
+        break;
+    default: break;
+    }
+
+    mType    = Type::Null;
+    mElement = Type::Null;
+    mSize    = 0;
+}
+
+std::string JsonValue::TypeName() const
+{
+    switch (mType)
+    {
+    case Type::Null: return GetTypeName<std::nullptr_t>();
+    case Type::Bool: return GetTypeName<bool>();
+    case Type::Int: return GetTypeName<int>();
+    case Type::Float: return GetTypeName<float>();
+    case Type::Double: return GetTypeName<double>();
+    case Type::Char: return GetTypeName<char>();
+    case Type::String: return GetTypeName<std::string>();
+    case Type::StringView: return GetTypeName<std::string_view>();
+    case Type::Object: return GetTypeName<std::shared_ptr<JsonObject>>();
+    case Type::InlineObject: return GetTypeName<JsonObject>();
+    case Type::Span:
+        return detail::WithElementType(mElement, []<typename E>(std::type_identity<E>) { return GetTypeName<std::span<E>>(); });
+    case Type::Array:
+        return detail::WithElementType(mElement, []<typename E>(std::type_identity<E>) { return GetTypeName<std::vector<E>>(); });
+    case Type::Boxed: return mData.box->TypeName();
+    }
+    return {};
+}
+
+void JsonValue::ThrowTypeMismatch(const std::string& expectedType, const std::string_view key) const
+{
+    std::string message = "Type mismatch: Expected '" + expectedType + "', but found '" + TypeName() + "'";
+    if (!key.empty())
+    {
+        message += " for key: ";
+        message += key;
+    }
+    if (mType == Type::StringView && expectedType == GetTypeName<std::string>())
+    {
+        message += ". Strings that aren't copied, such as every string read by MapFile, are read with "
+                   "Get<std::string_view>";
+    }
+    throw std::runtime_error(message);
+}
+
+void JsonValue::Write(std::string& out) const
+{
+    switch (mType)
+    {
+    case Type::Null: WriteItem(out, nullptr); break;
+    case Type::Bool: WriteItem(out, mData.b); break;
+    case Type::Int: WriteItem(out, mData.i); break;
+    case Type::Float: WriteItem(out, mData.f); break;
+    case Type::Double: WriteItem(out, mData.d); break;
+    case Type::Char: WriteItem(out, mData.c); break;
+    case Type::String: WriteItem(out, mData.string->value); break;
+    case Type::StringView: WriteItem(out, Get<std::string_view>()); break;
+    case Type::Object: Serializer<std::shared_ptr<JsonObject>>::Write(out, mData.object->value); break;
+    case Type::InlineObject: Serializer<JsonObject>::Write(out, mData.inlineObject->value); break;
+    case Type::Span:
+    case Type::Array:
+        detail::WithElementType(mElement, [this, &out]<typename E>(std::type_identity<E>) {
+            Serializer<std::span<E>>::Write(out, Get<std::span<E>>());
+        });
+        break;
+    case Type::Boxed: mData.box->Write(out); break;
+    }
+}
+
+void JsonValue::WriteCanonical(std::string& out) const
+{
+    switch (mType)
+    {
+    case Type::Int: WriteCanonicalNumber(out, mData.i); break;
+    case Type::Float: WriteCanonicalNumber(out, mData.f); break;
+    case Type::Double: WriteCanonicalNumber(out, mData.d); break;
+    case Type::Object:
+        if (mData.object->value)
+        {
+            JsonWriter writer(out);
+            mData.object->value->WriteCanonical(writer);
+        } else
+        {
+            WriteItem(out, nullptr);
+        }
+        break;
+    case Type::InlineObject:
+    {
+        JsonWriter writer(out);
+        mData.inlineObject->value.WriteCanonical(writer);
+        break;
+    }
+    case Type::Span:
+    case Type::Array:
+        detail::WithElementType(mElement, [this, &out]<typename E>(std::type_identity<E>) {
+            const std::span<E> elements = Get<std::span<E>>();
+            out += '[';
+            for (size_t i = 0; i < elements.size(); ++i)
+            {
+                if (i != 0)
+                {
+                    out += ',';
+                }
+                if constexpr (std::is_same_v<E, int> || std::is_floating_point_v<E>)
+                {
+                    WriteCanonicalNumber(out, elements[i]);
+                } else if constexpr (std::is_same_v<E, JsonObject>)
+                {
+                    JsonWriter writer(out);
+                    elements[i].WriteCanonical(writer);
+                } else if constexpr (std::is_same_v<E, std::shared_ptr<JsonObject>>)
+                {
+                    if (elements[i])
+                    {
+                        JsonWriter writer(out);
+                        elements[i]->WriteCanonical(writer);
+                    } else
+                    {
+                        WriteItem(out, nullptr);
+                    }
+                } else
+                {
+                    WriteItem(out, elements[i]);
+                }
+            }
+            out += ']';
+        });
+        break;
+    case Type::Boxed: mData.box->WriteCanonical(out); break;
+    default: Write(out); break;
+    }
+}
+
+void JsonValue::WriteElements(std::string& out, const size_t first, const size_t count) const
+{
+    detail::WithElementType(mElement, [this, &out, first, count]<typename E>(std::type_identity<E>) {
+        Serializer<std::span<E>>::Write(out, Get<std::span<E>>().subspan(first, count));
+    });
+}
+
+void JsonValue::WriteBinary(BinaryWriter& out) const
+{
+    switch (mType)
+    {
+    case Type::Null: out.WriteNull(); break;
+    case Type::Bool: out.WriteBool(mData.b); break;
+    case Type::Int: out.WriteInteger(mData.i); break;
+    case Type::Float: out.WriteFloat(mData.f); break;
+    case Type::Double: out.WriteDouble(mData.d); break;
+    case Type::Char: BinarySerializer<char>::Write(out, mData.c); break;
+    case Type::String: out.WriteString(mData.string->value); break;
+    case Type::StringView: out.WriteString(Get<std::string_view>()); break;
+    case Type::Object: BinarySerializer<std::shared_ptr<JsonObject>>::Write(out, mData.object->value); break;
+    case Type::InlineObject: BinarySerializer<JsonObject>::Write(out, mData.inlineObject->value); break;
+    case Type::Span:
+    case Type::Array:
+        detail::WithElementType(mElement, [this, &out]<typename E>(std::type_identity<E>) {
+            BinarySerializer<std::span<E>>::Write(out, Get<std::span<E>>());
+        });
+        break;
+    case Type::Boxed: mData.box->WriteBinary(out); break;
+    }
+}
+
+} // namespace cereal
@@ -0,0 +1,144 @@
+// ------------------------------------------------------------------------------
+//
+// Cereal
+//    Copyright 2025 Matthew Rogers
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// File Name: ValueMap
+// Date File Created: 10/17/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+
+#include "ValueMap.h"
+
+#include <bit>
+
+namespace cereal
+{
+
+namespace
+{
+
+constexpr uint64_t PositionMask = 0xFFFFFFFF;
+
+constexpr uint64_t MakeSlot(const uint64_t hash, const size_t position)
+{
+    return (hash & ~PositionMask) | (position + 1);
+}
+
+} // namespace
+
+std::pair<ValueMap::iterator, bool> ValueMap::Emplace(const std::string_view key, const bool view)
+{
+    if (const size_t position = IndexOf(key); position != mMembers.size())
+    {
+        return { mMembers.begin() + position, false };
+    }
+
+    // The key copies the characters into the map's resource unless it is a view
+    return Append(view ? Key::View(key) : Key(key, Key::allocator_type(mMembers.get_allocator())));
+}
+
+std::pair<ValueMap::iterator, bool> ValueMap::try_emplace(const HashedKey& key)
+{
+    if (const size_t position = IndexOf(key); position != mMembers.size())
+    {
+        return { mMembers.begin() + position, false };
+    }
+    return Append(Key(key.Text(), Key::allocator_type(mMembers.get_allocator())));
+}
+
+std::pair<ValueMap::iterator, bool> ValueMap::try_emplace(const Symbol& key)
+{
+    if (const size_t position = IndexOf(key); position != mMembers.size())
+    {
+        return { mMembers.begin() + position, false };
+    }
+    return Append(Key::Interned(key));
+}
+
+std::pair<ValueMap::iterator, bool> ValueMap::Append(Key&& key)
+{
+    CEREAL_INSTRUMENT_GROWTH(mMembers);
+    mMembers.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple());
+
+    if (!mIndex.empty())
+    {
+        if (mMembers.size() * 2 > mIndex.size())
+        {
+            Rebuild(mIndex.size() * 2);
+        } else
+        {
+            Insert(mMembers.size() - 1, mMembers.back().first.Hash());
+        }
+    } else if (mMembers.size() > IndexThreshold)
+    {
+        Rebuild(std::bit_ceil(mMembers.size() * 4));
+    }
+
+    return { mMembers.end() - 1, true };
+}
+
+size_t ValueMap::Lookup(const std::string_view key, const uint64_t hash, const Symbol* symbol) const
+{
+    const size_t mask = mIndex.size() - 1;
+
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        const uint64_t slot = mIndex[i];
+        if (slot == 0)
+        {
+            return mMembers.size();
+        }
+
+        const size_t position = (slot & PositionMask) - 1;
+        if ((slot & ~PositionMask) != (hash & ~PositionMask))
+        {
+            continue;
+        }
+
+        // Two interned keys are the same key only if they are the same symbol
+        const Key& candidate = mMembers[position].first;
+        if (symbol && candidate.GetSymbol() ? candidate.GetSymbol() == symbol : candidate == key)
+        {
+            return position;
+        }
+    }
+}
+
+void ValueMap::Insert(const size_t position, const uint64_t hash)
+{
+    const size_t mask = mIndex.size() - 1;
+
+    size_t i = hash & mask;
+    while (mIndex[i] != 0)
+    {
+        i = (i + 1) & mask;
+    }
+    mIndex[i] = MakeSlot(hash, position);
+}
+
+void ValueMap::Rebuild(const size_t capacity)
+{
+    CEREAL_INSTRUMENT_GROWTH(mIndex);
+    mIndex.assign(capacity, 0);
+    for (size_t position = 0; position < mMembers.size(); ++position)
+    {
+        Insert(position, mMembers[position].first.Hash());
+    }
+}
+
+} // namespace cereal
@@ -31,6 +31,11 @@ project "Test"
         "cereal"
     }
 
+    filter "system:linux"
+        links { "pthread" }
+
+    filter {}
+
     platform_defines()
 
 
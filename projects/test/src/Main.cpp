@@ -1,6 +1,8 @@
 #include "cereal/Cereal.h"
 
+#include <functional>
 #include <iostream>
+#include <unordered_map>
 #include <vector>
 
 
@@ -35,11 +37,9 @@ struct TestObject : public cereal::Serializable
         std::span<float> span = spanArray;
         json.Add("span", span);
 
-        // Vectors, arrays, etc must first be converted to a span
-        std::span<int> numSpan = nums;
-
-        // You can also add like this
-        json["spannum"] = numSpan;
+        // Vectors are copied into the object, or taken over without a copy when moved in. Spans only view memory the
+        // caller owns, which then has to outlive the object. You can also add like this
+        json["spannum"] = nums;
         json["letter"]  = c;
 
         std::span<bool> boolSpan = bools;
@@ -69,6 +69,8 @@ struct Vector2 : public cereal::Serializable
         json.Add("y", y);
         return std::make_shared<cereal::JsonObject>(json);
     }
+
+    CEREAL_DESCRIBE(Vector2, x, y)
 };
 
 struct Vector3 : public cereal::Serializable
@@ -90,11 +92,117 @@ struct Vector3 : public cereal::Serializable
 
         return std::make_shared<cereal::JsonObject>(json);
     }
+
+    CEREAL_DESCRIBE(Vector3, x, y, z, pos)
 };
 
+// Numbers RFC 8259 doesn't allow. Every way of reading json has to turn them down
+constexpr std::string_view MalformedNumbers[] = { "01", "-00", "1.", "2.e5" };
+
+bool Rejects(const std::function<void()>& read)
+{
+    try
+    {
+        read();
+    } catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+bool CheckMalformedNumbers()
+{
+    bool ok = true;
+    for (const auto number : MalformedNumbers)
+    {
+        // Complete otherwise, so the number is the only thing Deserialize<Vector2> can object to
+        const std::string json = R"({"x": )" + std::string(number) + R"(, "y": 1})";
+
+        const bool reader = Rejects([&] {
+            cereal::StringSource source(json);
+            cereal::JsonReader   events(source);
+            cereal::JsonHandler  handler;
+            events.Parse(handler);
+        });
+        const bool parse       = Rejects([&] { (void) cereal::JsonObject::Parse(json); });
+        const bool deserialize = Rejects([&] { (void) cereal::Deserialize<Vector2>(json); });
+
+        if (!reader || !parse || !deserialize)
+        {
+            std::cout << "Malformed number " << number << " accepted by" << (reader ? "" : " JsonReader")
+                      << (parse ? "" : " Parse") << (deserialize ? "" : " Deserialize") << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// A shared child changed through an array has to show up in the cached output just like it does in ToString
+bool CheckCachedOutput()
+{
+    auto element = std::make_shared<cereal::JsonObject>();
+    element->Add("x", 1);
+
+    cereal::JsonObject built;
+    built.Add("arr", std::vector{ element });
+
+    auto parsed = cereal::JsonObject::Parse(R"({"list": [{"a": 1}, {"a": 2}]})");
+
+    bool ok = true;
+    for (const bool pretty : { false, true })
+    {
+        (void) built.ToStringCached(pretty);
+        (void) parsed.ToStringCached(pretty);
+        element->Add("x", pretty ? 3 : 2);
+        parsed.GetSpan<std::shared_ptr<cereal::JsonObject>>("list")[0]->Add("a", pretty ? 6 : 5);
+
+        for (const auto* json : { &built, &parsed })
+        {
+            if (json->ToStringCached(pretty) != json->ToString(pretty))
+            {
+                std::cout << "Stale cached output: " << json->ToStringCached(pretty) << std::endl;
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+// Canonical output can't depend on the order a boxed map's buckets happen to be in
+bool CheckCanonicalOutput()
+{
+    std::unordered_map<std::string, int> spread;
+    spread.reserve(64);
+    std::unordered_map<std::string, int> packed;
+    for (const char* key : { "c", "a", "b", "e", "d" })
+    {
+        spread[key] = key[0] - 'a';
+        packed[key] = key[0] - 'a';
+    }
+
+    cereal::JsonObject first;
+    first.Add("map", spread);
+    cereal::JsonObject second;
+    second.Add("map", packed);
+
+    const std::string expected = R"({"map":{"a":0,"b":1,"c":2,"d":3,"e":4}})";
+    if (first.ToCanonicalString() != expected || second.ToCanonicalString() != expected)
+    {
+        std::cout << "Canonical output out of order: " << first.ToCanonicalString() << " "
+                  << second.ToCanonicalString() << std::endl;
+        return false;
+    }
+    return true;
+}
 
 int main()
 {
+    if (!CheckMalformedNumbers() || !CheckCachedOutput() || !CheckCanonicalOutput())
+    {
+        return 1;
+    }
+
     try
     {
         TestObject obj;
@@ -129,6 +237,13 @@ int main()
         double ySpeed = jsonRoot->GetObject("child").GetObject("3dcoord").Get<double>("y");
         std::cout << "Y speed: " << ySpeed << std::endl;
 
+        // Described types skip the JsonObject entirely and are written straight into the output
+        std::cout << "Described: " << cereal::Serialize(vec) << std::endl;
+
+        // And read straight back out of the text, without a JsonObject in between
+        const auto readBack = cereal::Deserialize<Vector3>(cereal::Serialize(vec));
+        std::cout << "Read back pos.y: " << readBack.pos.y << std::endl;
+
         const auto& json         = *jsonRoot;
         auto&       nonconstJson = *jsonRoot;
 
@@ -144,6 +259,10 @@ int main()
         // jsonRoot->PrintToFile("./sample.json", true, 8); // pretty print with 8 spaces for tabs
         jsonRoot->PrintToFile("./sample.json", true); // pretty print with default 4 spaces for tabs
 
+        // And read it back in
+        const auto fromFile = cereal::JsonObject::ParseFile("./sample.json");
+        std::cout << "Child fruit from file: " << fromFile.GetObject("child").Get<std::string>("fruit") << std::endl;
+
         // show-casing type mismatch error
         int z = json["child"]["3dcoord"]["z"];
 